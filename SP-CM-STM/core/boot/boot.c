@@ -0,0 +1,574 @@
+///////////////////////////////////////////////////////////////////////////////
+//! \file boot.c
+//! \brief This module writes a new application image sent over the CP link
+//!
+//! The image comes in a 512 byte flash segment at a time (see
+//! \ref msg_update). A segment is collected in RAM and only erased and
+//! written once all of it is in, so a corrupt or missing chunk never leaves
+//! a half written segment behind. The CPU is held while the flash is busy,
+//! so the CP Board waits for the UPDATE_ACK of a segment before it sends the
+//! next one.
+//!
+//! This module, the \ref comm Module and the C startup code make up the
+//! BOOT link, which is never written (see \ref boot). The interrupt vector
+//! segment belongs to the BOOT area as well, so the reset vector always
+//! leads here and \e main() of this module starts the application. The
+//! interrupts of the application go through trampolines to the application
+//! vector table, which is written with the rest of the image. While the
+//! application is being rewritten nothing else may run, so the interrupts
+//! of the other modules are shut off first.
+//!
+//! @addtogroup core
+//! @{
+//!
+//! @addtogroup boot Firmware Update
+//! @{
+///////////////////////////////////////////////////////////////////////////////
+//*****************************************************************************
+//     Wireless Networks Research Lab
+//     Dept of Electrical Engineering, CEFNS
+//     Northern Arizona University
+//*****************************************************************************
+
+// This module is in the BOOT link and calls itself directly, not through
+// the jump table of boot.h
+#define BOOT_RESIDENT
+
+#include <msp430x23x.h>
+#include "../core.h"
+
+#if SP_FIRMWARE_UPDATE
+
+#if !SP_COMM_FRAMED
+#error "SP_FIRMWARE_UPDATE needs SP_COMM_FRAMED"
+#endif
+
+//! @name Flash Timing
+//! @{
+//! \def BOOT_FLASH_DIVIDER
+//! \brief The FN bits that bring the 16 MHz MCLK into the 257 to 476 kHz
+//! range of the flash timing generator (MCLK / 40)
+#define BOOT_FLASH_DIVIDER   (FN5 + FN2 + FN1 + FN0)
+//! @}
+
+//! \def BOOT_NO_SEGMENT
+//! \brief Value of g_ucBOOT_Segment when no segment is being collected
+#define BOOT_NO_SEGMENT      0xFF
+
+//******************  Control and Indication Variables  *********************//
+//! @name Control and Indication Variables
+//! These variables hold the state of the update. They are set up by
+//! \e vBOOT_Run(), the C startup does not initialize them on the way into
+//! \e vBOOT_Recover().
+//! @{
+//! \var uint16 g_unaBOOT_Segment
+//! \brief The segment being collected, kept in words for the flash writes.
+//! It is only used once the application has stopped, so it shares the RAM
+//! of the application instead of taking up BOOT RAM.
+#pragma DATA_SECTION(g_unaBOOT_Segment, ".bootbuf")
+uint16 g_unaBOOT_Segment[SP_UPDATE_SEGMENT_SIZE / 2];
+//! \var uint8 g_ucBOOT_Segment
+//! \brief The number of the segment in \e g_unaBOOT_Segment
+uint8 g_ucBOOT_Segment;
+//! \var uint32 g_ulBOOT_ChunksMissing
+//! \brief A bit for each chunk of the segment that has not come in yet
+uint32 g_ulBOOT_ChunksMissing;
+//! \var uint16 g_unBOOT_ImageSegments
+//! \brief The number of application segments in the image, 0 until an
+//! UPDATE_START_PKT is taken
+uint16 g_unBOOT_ImageSegments;
+//! \var uint16 g_unBOOT_ImageCRC
+//! \brief The CRC of the image sent in the UPDATE_START_PKT
+uint16 g_unBOOT_ImageCRC;
+//! @}
+
+//******************  Interrupt Trampolines  ********************************//
+//! @name Interrupt Trampolines
+//! The vector segment is never written, so every vector the application may
+//! use points to a trampoline here instead. The trampoline jumps through the
+//! word of the application vector table at BOOT_APP_VECTORS for the same
+//! vector, and the ISR of the application returns from the interrupt as if
+//! it had been called by the hardware. PORT2, TIMERA1 and TIMERA0 belong to
+//! the \ref comm Module and the reset vector to the C startup, so these
+//! point straight into the BOOT area. The .bootintNN sections are placed on
+//! the vectors by lnk_msp430f235_boot.cmd.
+//! @{
+//! \def BOOT_STRING
+//! \brief Turns the value of a define into a string
+#define BOOT_STRING(x)       BOOT_STRING_(x)
+#define BOOT_STRING_(x)      #x
+//! \def BOOT_TRAMPOLINE
+//! \brief Builds the trampoline of vector ucVector, given as two digits
+#define BOOT_TRAMPOLINE(ucVector) \
+  asm("\t.sect \".bootint" #ucVector "\""); \
+  asm("\t.word BOOT_Int" #ucVector); \
+  asm("\t.text"); \
+  asm("BOOT_Int" #ucVector ":\tBR &(" BOOT_STRING(BOOT_APP_VECTORS) " + 2 * " #ucVector ")")
+
+BOOT_TRAMPOLINE(00);
+BOOT_TRAMPOLINE(01);
+BOOT_TRAMPOLINE(02);
+BOOT_TRAMPOLINE(04);
+BOOT_TRAMPOLINE(05);
+BOOT_TRAMPOLINE(06);
+BOOT_TRAMPOLINE(07);
+BOOT_TRAMPOLINE(10);
+BOOT_TRAMPOLINE(11);
+BOOT_TRAMPOLINE(12);
+BOOT_TRAMPOLINE(13);
+BOOT_TRAMPOLINE(14);
+//! @}
+
+//******************  Jump Table  ******************************************//
+//! \var g_BOOT_JumpTable
+//! \brief The jump table of the BOOT link, placed at BOOT_JUMP_TABLE by
+//! lnk_msp430f235_boot.cmd. The entries are in the order of
+//! struct BOOT_JumpTable.
+#pragma DATA_SECTION(g_BOOT_JumpTable, ".bootjump")
+const struct BOOT_JumpTable g_BOOT_JumpTable =
+{
+  vCOMM_Init,
+  vCOMM_SetBaud,
+  unCOMM_GetBaud,
+  unCOMM_BaudForRate,
+  vCOMM_WaitFor32BitDataMessage,
+  ucCOMM_WaitFor32BitDataMessageTimeout,
+  vCOMM_WaitForTXComplete,
+  vCOMM_Send32BitDataMessage,
+  vCOMM_SendNoChange,
+#if SP_PACKET_SIZE_128
+  vCOMM_Send128BitDataMessage,
+#else
+  NULL,
+#endif
+#if SP_PACKET_VARIABLE
+  vCOMM_SendVarDataMessage,
+#else
+  NULL,
+#endif
+  vCOMM_SendBatchReport,
+  vCOMM_SendLabelMessage,
+  vCOMM_ResendLastMessage,
+  p_COMM_Take32BitDataMessage,
+  vCOMM_ReleaseMessage,
+  ucCOMM_IsRepeatedRequest,
+  vCOMM_ForgetRequest,
+  ucCOMM_RXPending,
+  vCOMM_SendLinkStatus,
+  vBOOT_Run,
+  ucCOMM_IsRunning
+};
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Erases a flash segment
+//!
+//! The CPU is held until the erase is done. Interrupts must be off.
+//!   \param p_unSegment Any address in the segment
+//!   \return None
+///////////////////////////////////////////////////////////////////////////////
+void vBOOT_EraseSegment(volatile uint16 * p_unSegment)
+{
+  FCTL3 = FWKEY;
+  FCTL1 = FWKEY + ERASE;
+  // The dummy write starts the erase
+  *p_unSegment = 0x0000;
+  FCTL1 = FWKEY;
+  FCTL3 = FWKEY + LOCK;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Writes words to erased flash
+//!
+//! The CPU is held during each write. Interrupts must be off.
+//!   \param p_unDest Where to write, in erased flash
+//!   \param p_unSource The words to write
+//!   \param unWords The number of words
+//!   \return None
+///////////////////////////////////////////////////////////////////////////////
+void vBOOT_WriteWords(volatile uint16 * p_unDest, uint16 * p_unSource, uint16 unWords)
+{
+  FCTL3 = FWKEY;
+  FCTL1 = FWKEY + WRT;
+  while (unWords--)
+    p_unDest[unWords] = p_unSource[unWords];
+  FCTL1 = FWKEY;
+  FCTL3 = FWKEY + LOCK;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Sends an UPDATE_ACK
+//!   \param ucStatus The \ref SP_UPDATE_OK "update status"
+//!   \param ulData What goes in data1 (high word) and data2 (low word)
+//!   \return None
+///////////////////////////////////////////////////////////////////////////////
+void vBOOT_SendAck(uint8 ucStatus, uint32 ulData)
+{
+  union SP_32BitDataMessage AckMsg;
+
+  AckMsg.fields.ucMsgVersion = SP_DATAMESSAGE_VERSION;
+  AckMsg.fields.ucMsgSize = SP_32BITDATAMESSAGE_SIZE;
+  AckMsg.fields.ucMsgType = UPDATE_ACK;
+  AckMsg.fields.ucSensorNumber = ucStatus;
+  AckMsg.fields.ucData1_HI_BYTE = (uint8)(ulData >> 24);
+  AckMsg.fields.ucData1_LO_BYTE = (uint8)(ulData >> 16);
+  AckMsg.fields.ucData2_HI_BYTE = (uint8)(ulData >> 8);
+  AckMsg.fields.ucData2_LO_BYTE = (uint8)ulData;
+
+  vCOMM_Send32BitDataMessage(&AckMsg);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Puts the chunk of an UPDATE_DATA_PKT in the segment buffer
+//!
+//! A chunk for another segment starts that segment over. Chunks with a bad
+//! size or number are dropped, the UPDATE_ACK of the segment reports them as
+//! missing.
+//!   \param p_Chunk Pointer to the UPDATE_DATA_PKT
+//!   \return None
+///////////////////////////////////////////////////////////////////////////////
+void vBOOT_TakeChunk(union SP_UpdateDataMessage * p_Chunk)
+{
+  uint8 * p_ucDest;
+  uint8 ucLoopCount;
+
+  if ((p_Chunk->fields.ucMsgSize != SP_UPDATEDATAMESSAGE_SIZE) ||
+      (p_Chunk->fields.ucChunk >= SP_UPDATE_CHUNKS))
+    return;
+
+  if (p_Chunk->fields.ucSegment != g_ucBOOT_Segment)
+  {
+    g_ucBOOT_Segment = p_Chunk->fields.ucSegment;
+    g_ulBOOT_ChunksMissing = 0xFFFFFFFF;
+  }
+
+  p_ucDest = (uint8 *)g_unaBOOT_Segment +
+             (uint16)p_Chunk->fields.ucChunk * SP_UPDATE_CHUNK_SIZE;
+  for (ucLoopCount = 0x00; ucLoopCount < SP_UPDATE_CHUNK_SIZE; ucLoopCount++)
+    p_ucDest[ucLoopCount] = p_Chunk->fields.ucaData[ucLoopCount];
+
+  g_ulBOOT_ChunksMissing &= ~(1UL << p_Chunk->fields.ucChunk);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Erases and writes the collected segment
+//!
+//! Only the segments of the image announced by the UPDATE_START_PKT may be
+//! written, nothing is written before one is taken. The BOOT area and the
+//! vector segment after it are never touched. The update record is set
+//! before the first segment of the application is erased.
+//!   \param ucSegment The segment number from the UPDATE_WRITE_PKT
+//!   \return The \ref SP_UPDATE_OK "update status"
+///////////////////////////////////////////////////////////////////////////////
+uint8 ucBOOT_WriteSegment(uint8 ucSegment)
+{
+  volatile uint16 * p_unSegment;
+  uint16 unPending;
+  uint16 unIndex;
+
+  if (g_unBOOT_ImageSegments == 0x0000)
+    return SP_UPDATE_BAD_IMAGE;
+
+  if ((ucSegment != g_ucBOOT_Segment) || g_ulBOOT_ChunksMissing)
+    return SP_UPDATE_MISSING;
+
+  if (ucSegment >= g_unBOOT_ImageSegments)
+    return SP_UPDATE_BAD_SEGMENT;
+
+  p_unSegment = (volatile uint16 *)(BOOT_APP_START +
+                                    (uint16)ucSegment * SP_UPDATE_SEGMENT_SIZE);
+
+  // The TimerA ISRs would be held up along with the CPU
+  vCOMM_WaitForTXComplete();
+  __bic_SR_register(GIE);
+
+  // From here on the application is not whole until the image checks out
+  if (*BOOT_RECORD != BOOT_UPDATE_PENDING)
+  {
+    unPending = BOOT_UPDATE_PENDING;
+    vBOOT_EraseSegment(BOOT_RECORD);
+    vBOOT_WriteWords(BOOT_RECORD, &unPending, 1);
+  }
+
+  vBOOT_EraseSegment(p_unSegment);
+  vBOOT_WriteWords(p_unSegment, g_unaBOOT_Segment, SP_UPDATE_SEGMENT_SIZE / 2);
+  __bis_SR_register(GIE);
+
+  // The buffer has to be sent again to write the segment again
+  g_ucBOOT_Segment = BOOT_NO_SEGMENT;
+
+  for (unIndex = 0x0000; unIndex < SP_UPDATE_SEGMENT_SIZE / 2; unIndex++)
+  {
+    if (p_unSegment[unIndex] != g_unaBOOT_Segment[unIndex])
+      return SP_UPDATE_FLASH_ERROR;
+  }
+
+  return SP_UPDATE_OK;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Works out the CRC of the BOOT area on this SP Board
+//!
+//! The CRC is the same CRC-16 as the image CRC, over the BOOT area and the
+//! vector segment, from BOOT_AREA_START to the end of flash.
+//!   \param None
+//!   \return The CRC of the BOOT area
+///////////////////////////////////////////////////////////////////////////////
+uint16 unBOOT_AreaCRC(void)
+{
+  uint8 * p_ucBoot;
+  uint16 unSize;
+  uint16 unCRC;
+
+  p_ucBoot = (uint8 *)BOOT_AREA_START;
+  unSize = (uint16)(0x0000 - BOOT_AREA_START);
+  unCRC = 0xFFFF;
+  while (unSize--)
+    unCRC = unCOMM_CRC16Update(unCRC, *p_ucBoot++);
+
+  return unCRC;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Checks the application image
+//!
+//! The CRC covers the application segments of the image, which start with
+//! the application vector table.
+//!   \param None
+//!   \return SP_UPDATE_OK or SP_UPDATE_BAD_IMAGE
+///////////////////////////////////////////////////////////////////////////////
+uint8 ucBOOT_CheckImage(void)
+{
+  uint8 * p_ucImage;
+  uint16 unSize;
+  uint16 unCRC;
+
+  if ((g_unBOOT_ImageSegments == 0x0000) ||
+      (g_unBOOT_ImageSegments > BOOT_APP_SEGMENTS))
+    return SP_UPDATE_BAD_IMAGE;
+
+  p_ucImage = (uint8 *)BOOT_APP_START;
+  unSize = g_unBOOT_ImageSegments * SP_UPDATE_SEGMENT_SIZE;
+  unCRC = 0xFFFF;
+  while (unSize--)
+    unCRC = unCOMM_CRC16Update(unCRC, *p_ucImage++);
+
+  if (unCRC != g_unBOOT_ImageCRC)
+    return SP_UPDATE_BAD_IMAGE;
+
+  return SP_UPDATE_OK;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Handles one message during the update
+//!
+//! Anything but the UPDATE packets is answered with SP_UPDATE_BUSY. An
+//! UPDATE_START_PKT for another BOOT area is answered with
+//! SP_UPDATE_WRONG_BOOT, and if the application was not touched yet the
+//! SP Board restarts into it. Once the image checks out, the update record
+//! is erased and the SP Board restarts into the new application.
+//!   \param p_Message The message, in its RX message buffer
+//!   \return None
+///////////////////////////////////////////////////////////////////////////////
+void vBOOT_HandleMessage(union SP_32BitDataMessage * p_Message)
+{
+  union SP_128BitDataMessage * p_Start;
+  uint8 ucStatus;
+  uint16 unBootCRC;
+
+  switch (p_Message->fields.ucMsgType)
+  {
+    case UPDATE_START_PKT:
+      p_Start = (union SP_128BitDataMessage *)p_Message;
+      unBootCRC = unBOOT_AreaCRC();
+      g_unBOOT_ImageSegments = 0x0000;
+      g_ucBOOT_Segment = BOOT_NO_SEGMENT;
+
+      if ((p_Start->fields.ucMsgSize < SP_128BITDATAMESSAGE_SIZE) ||
+          ((((uint16)p_Start->fields.ucData3_HI_BYTE << 8) |
+            p_Start->fields.ucData3_LO_BYTE) != unBootCRC))
+      {
+        vBOOT_SendAck(SP_UPDATE_WRONG_BOOT,
+                      ((uint32)BOOT_APP_SEGMENTS << 16) | unBootCRC);
+
+        // Nothing was written yet, so the application is still whole
+        if (*BOOT_RECORD != BOOT_UPDATE_PENDING)
+        {
+          vCOMM_WaitForTXComplete();
+          WDTCTL = 0x0000;
+        }
+        break;
+      }
+
+      g_unBOOT_ImageSegments =
+        ((uint16)p_Start->fields.ucData1_HI_BYTE << 8) | p_Start->fields.ucData1_LO_BYTE;
+      g_unBOOT_ImageCRC =
+        ((uint16)p_Start->fields.ucData2_HI_BYTE << 8) | p_Start->fields.ucData2_LO_BYTE;
+
+      if (g_unBOOT_ImageSegments > BOOT_APP_SEGMENTS)
+        g_unBOOT_ImageSegments = 0x0000;
+
+      vBOOT_SendAck((g_unBOOT_ImageSegments == 0x0000) ? SP_UPDATE_BAD_IMAGE : SP_UPDATE_OK,
+                    ((uint32)BOOT_APP_SEGMENTS << 16) | unBootCRC);
+      break;
+
+    case UPDATE_DATA_PKT:
+      vBOOT_TakeChunk((union SP_UpdateDataMessage *)p_Message);
+      break;
+
+    case UPDATE_WRITE_PKT:
+      ucStatus = ucBOOT_WriteSegment(p_Message->fields.ucSensorNumber);
+      if (ucStatus == SP_UPDATE_MISSING)
+      {
+        if (p_Message->fields.ucSensorNumber != g_ucBOOT_Segment)
+          vBOOT_SendAck(ucStatus, 0xFFFFFFFF);
+        else
+          vBOOT_SendAck(ucStatus, g_ulBOOT_ChunksMissing);
+      }
+      else
+        vBOOT_SendAck(ucStatus, p_Message->fields.ucSensorNumber);
+      break;
+
+    case UPDATE_FINISH_PKT:
+      ucStatus = ucBOOT_CheckImage();
+      if (ucStatus == SP_UPDATE_OK)
+      {
+        // The new application is good, from now on the board starts it
+        vCOMM_WaitForTXComplete();
+        __bic_SR_register(GIE);
+        vBOOT_EraseSegment(BOOT_RECORD);
+        __bis_SR_register(GIE);
+      }
+      vBOOT_SendAck(ucStatus, g_unBOOT_ImageSegments);
+
+      if (ucStatus == SP_UPDATE_OK)
+      {
+        vCOMM_WaitForTXComplete();
+        // A write without the password resets the MSP430
+        WDTCTL = 0x0000;
+      }
+      break;
+
+    default:
+      vBOOT_SendAck(SP_UPDATE_BUSY, 0x00000000);
+      break;
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Runs the firmware update, never returns
+//!
+//! The interrupts of everything outside the BOOT area are shut off, then the
+//! UPDATE packets are handled until the SP Board restarts into the new
+//! application.
+//!   \param p_StartMessage The UPDATE_START_PKT taken by the core, or NULL
+//!   \return None
+//!   \sa vBOOT_Recover()
+///////////////////////////////////////////////////////////////////////////////
+void vBOOT_Run(union SP_32BitDataMessage * p_StartMessage)
+{
+  union SP_32BitDataMessage * p_Message;
+
+  __bic_SR_register(GIE);
+  IE1 &= ~WDTIE;
+  IE2 = 0x00;
+  P1IE = 0x00;
+  ADC12IE = 0x0000;
+  TBCTL = 0x0000;
+  TBCCTL0 = 0x0000;
+  TBCCTL1 = 0x0000;
+  TBCCTL2 = 0x0000;
+  __bis_SR_register(GIE);
+
+  FCTL2 = FWKEY + FSSEL_1 + BOOT_FLASH_DIVIDER;
+
+  g_ucBOOT_Segment = BOOT_NO_SEGMENT;
+  g_ulBOOT_ChunksMissing = 0xFFFFFFFF;
+  g_unBOOT_ImageSegments = 0x0000;
+  g_unBOOT_ImageCRC = 0x0000;
+
+  if (p_StartMessage != NULL)
+  {
+    vBOOT_HandleMessage(p_StartMessage);
+    vCOMM_ReleaseMessage();
+  }
+
+  while (TRUE)
+  {
+    vCOMM_WaitFor32BitDataMessage();
+    p_Message = p_COMM_Take32BitDataMessage();
+
+    if (ucCOMM_IsRepeatedRequest())
+      vCOMM_ResendLastMessage();
+    else
+      vBOOT_HandleMessage(p_Message);
+
+    vCOMM_ReleaseMessage();
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Brings up the CP link after a restart during an update
+//!
+//! Sets up the clocks like \e vCORE_Initilize() and starts the link at the
+//! rate the core starts it at, then waits for the CP Board to send the image
+//! again.
+//!   \param None
+//!   \return None
+//!   \sa _system_pre_init()
+///////////////////////////////////////////////////////////////////////////////
+void vBOOT_Recover(void)
+{
+  DCOCTL  = CALDCO_16MHZ;
+  BCSCTL1 = CALBC1_16MHZ;
+#if SP_SMCLK_16MHZ
+  BCSCTL2 = SELM_0 | DIVM_0 | DIVS_0;
+#else
+  BCSCTL2 = SELM_0 | DIVM_0 | DIVS_2;
+#endif
+
+  vCOMM_Init(BAUD_115200);
+  __bis_SR_register(GIE);
+
+  vBOOT_Run(NULL);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Called by the C startup code of the BOOT link before the variables
+//! are set up
+//!
+//! If the update record shows the application was not finished, or there
+//! is no application at all, the application is not started and the update
+//! is picked up again. No variable may be read before it is set from here
+//! on, the C startup never gets to initialize them.
+//!   \param None
+//!   \return 1, so the C startup code initializes the variables
+///////////////////////////////////////////////////////////////////////////////
+int _system_pre_init(void)
+{
+  WDTCTL = WDTPW + WDTHOLD;
+
+  if ((*BOOT_RECORD == BOOT_UPDATE_PENDING) ||
+      (*(uint16 *)BOOT_APP_RESET == 0xFFFF))
+    vBOOT_Recover();
+
+  return 1;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief The main function of the BOOT link, starts the application
+//!
+//! The application has its own C startup code, it sets up the stack and the
+//! variables of the application and calls its own main function.
+//!   \param None
+//!   \return Never returns
+///////////////////////////////////////////////////////////////////////////////
+int main(void)
+{
+  (*(void (**)(void))BOOT_APP_RESET)();
+
+  return 0;
+}
+
+#endif
+//! @}
+//! @}
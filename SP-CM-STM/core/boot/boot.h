@@ -0,0 +1,151 @@
+///////////////////////////////////////////////////////////////////////////////
+//! \file boot.h
+//! \brief Header file for the firmware update module
+//!
+//! This file provides all of the defines and function prototypes for the
+//! \ref boot Module.
+//!
+//! @addtogroup core
+//! @{
+//!
+//! @addtogroup boot Firmware Update
+//! The firmware update module takes a new application image over the CP
+//! link and writes it to flash. If the update does not finish, the SP Board
+//! comes back up in this module until the CP Board sends the image again.
+//!
+//! With SP_FIRMWARE_UPDATE set the SP Board firmware is linked twice:
+//! - the BOOT link, of boot.c and comm.c with lnk_msp430f235_boot.cmd. It is
+//!   programmed once and never rewritten. It owns the vector segment, its
+//!   own C startup and helpers, and the BOOT RAM.
+//! - the application link, of the other sources with
+//!   lnk_msp430f235_app.cmd. This is the image that is sent in an update.
+//!
+//! The application reaches the BOOT link only through the jump table at
+//! BOOT_JUMP_TABLE, so the layout of the BOOT area does not have to match
+//! anything in the image. An image is still only good for the BOOT area it
+//! was linked against, as the message layouts and switches must agree, so
+//! the UPDATE_START_PKT carries the CRC of that BOOT area and is refused on
+//! any other.
+//! @{
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef BOOT_H_
+  #define BOOT_H_
+
+  //! @name Memory Layout
+  //! These must match lnk_msp430f235_boot.cmd and lnk_msp430f235_app.cmd.
+  //! @{
+  //! \def BOOT_APP_START
+  //! \brief The address of segment 0, the start of the application area
+  #define BOOT_APP_START        0xC000
+  //! \def BOOT_APP_SEGMENTS
+  //! \brief The number of segments in the application area
+  #define BOOT_APP_SEGMENTS     23
+  //! \def BOOT_AREA_START
+  //! \brief The start of the BOOT area, which is never written. It runs to
+  //! the end of flash, the vector segment included.
+  #define BOOT_AREA_START       0xEE00
+  //! \def BOOT_JUMP_TABLE
+  //! \brief The address of the jump table, at the start of the BOOT area
+  #define BOOT_JUMP_TABLE       BOOT_AREA_START
+  //! \def BOOT_APP_VECTORS
+  //! \brief The application vector table, at the start of segment 0
+  //!
+  //! It has a word for each interrupt vector, in the order of the vector
+  //! segment. The vectors the application may use point to trampolines in
+  //! the BOOT area, which jump through this table.
+  #define BOOT_APP_VECTORS      0xC000
+  //! \def BOOT_APP_RESET
+  //! \brief The word after the application vector table, where the
+  //! application reset vector goes. The BOOT area starts the application
+  //! through it.
+  #define BOOT_APP_RESET        (BOOT_APP_VECTORS + 0x1E)
+  //! @}
+
+  //! @name Update Record
+  //! The update record is kept in info segment B. While an update is being
+  //! written it holds BOOT_UPDATE_PENDING, once the image checks out the
+  //! segment is erased again. An erased record means the application is good,
+  //! so a freshly programmed board starts normally.
+  //! @{
+  //! \def BOOT_RECORD
+  //! \brief The update record, a word in info segment B
+  #define BOOT_RECORD           ((volatile uint16 *)0x1080)
+  //! \def BOOT_UPDATE_PENDING
+  //! \brief The update record value while the application is being written
+  #define BOOT_UPDATE_PENDING   0x5AA5
+  //! @}
+
+  //! @name Control Functions
+  //! These functions handle controlling the \ref boot Module.
+  //! @{
+  void vBOOT_Run(union SP_32BitDataMessage * p_StartMessage);
+  void vBOOT_Recover(void);
+  int _system_pre_init(void);
+  //! @}
+
+  //! \brief The jump table of the BOOT link
+  //!
+  //! Every function of the BOOT link that the application calls has an
+  //! entry. The entries never move: a new one goes at the end, and one that
+  //! is not built in is NULL.
+  struct BOOT_JumpTable
+  {
+    void (*p_vCOMM_Init)(uint16 unBaud);
+    void (*p_vCOMM_SetBaud)(uint16 unBaud);
+    uint16 (*p_unCOMM_GetBaud)(void);
+    uint16 (*p_unCOMM_BaudForRate)(uint16 unRate);
+    void (*p_vCOMM_WaitFor32BitDataMessage)(void);
+    uint8 (*p_ucCOMM_WaitFor32BitDataMessageTimeout)(uint8 ucOverflows);
+    void (*p_vCOMM_WaitForTXComplete)(void);
+    void (*p_vCOMM_Send32BitDataMessage)(union SP_32BitDataMessage * p_DataMessage);
+    void (*p_vCOMM_SendNoChange)(uint8 ucSensorNumber);
+    void (*p_vCOMM_Send128BitDataMessage)(union SP_128BitDataMessage * p_DataRetMessage);
+    void (*p_vCOMM_SendVarDataMessage)(union SP_VarDataMessage * p_VarDataMessage);
+    void (*p_vCOMM_SendBatchReport)(union SP_BatchReportMessage * p_BatchReport);
+    void (*p_vCOMM_SendLabelMessage)(union SP_LabelMessage * p_LabelMessage);
+    void (*p_vCOMM_ResendLastMessage)(void);
+    union SP_32BitDataMessage * (*p_p_COMM_Take32BitDataMessage)(void);
+    void (*p_vCOMM_ReleaseMessage)(void);
+    uint8 (*p_ucCOMM_IsRepeatedRequest)(void);
+    void (*p_vCOMM_ForgetRequest)(void);
+    uint8 (*p_ucCOMM_RXPending)(void);
+    void (*p_vCOMM_SendLinkStatus)(uint8 ucClear);
+    void (*p_vBOOT_Run)(union SP_32BitDataMessage * p_StartMessage);
+    uint8 (*p_ucCOMM_IsRunning)(void);
+  };
+
+  //! \def BOOT_JUMP
+  //! \brief The jump table of the BOOT link on this SP Board
+  #define BOOT_JUMP (*(const struct BOOT_JumpTable *)BOOT_JUMP_TABLE)
+
+  // The application calls the BOOT link through the jump table. boot.c and
+  // comm.c define BOOT_RESIDENT, they are in the BOOT link themselves.
+  #if SP_FIRMWARE_UPDATE && !defined(BOOT_RESIDENT)
+    #define vCOMM_Init                          (BOOT_JUMP.p_vCOMM_Init)
+    #define vCOMM_SetBaud                       (BOOT_JUMP.p_vCOMM_SetBaud)
+    #define unCOMM_GetBaud                      (BOOT_JUMP.p_unCOMM_GetBaud)
+    #define unCOMM_BaudForRate                  (BOOT_JUMP.p_unCOMM_BaudForRate)
+    #define vCOMM_WaitFor32BitDataMessage       (BOOT_JUMP.p_vCOMM_WaitFor32BitDataMessage)
+    #define ucCOMM_WaitFor32BitDataMessageTimeout (BOOT_JUMP.p_ucCOMM_WaitFor32BitDataMessageTimeout)
+    #define vCOMM_WaitForTXComplete             (BOOT_JUMP.p_vCOMM_WaitForTXComplete)
+    #define vCOMM_Send32BitDataMessage          (BOOT_JUMP.p_vCOMM_Send32BitDataMessage)
+    #define vCOMM_SendNoChange                  (BOOT_JUMP.p_vCOMM_SendNoChange)
+    #define vCOMM_Send128BitDataMessage         (BOOT_JUMP.p_vCOMM_Send128BitDataMessage)
+    #define vCOMM_SendVarDataMessage            (BOOT_JUMP.p_vCOMM_SendVarDataMessage)
+    #define vCOMM_SendBatchReport               (BOOT_JUMP.p_vCOMM_SendBatchReport)
+    #define vCOMM_SendLabelMessage              (BOOT_JUMP.p_vCOMM_SendLabelMessage)
+    #define vCOMM_ResendLastMessage             (BOOT_JUMP.p_vCOMM_ResendLastMessage)
+    #define p_COMM_Take32BitDataMessage         (BOOT_JUMP.p_p_COMM_Take32BitDataMessage)
+    #define vCOMM_ReleaseMessage                (BOOT_JUMP.p_vCOMM_ReleaseMessage)
+    #define ucCOMM_IsRepeatedRequest            (BOOT_JUMP.p_ucCOMM_IsRepeatedRequest)
+    #define vCOMM_ForgetRequest                 (BOOT_JUMP.p_vCOMM_ForgetRequest)
+    #define ucCOMM_RXPending                    (BOOT_JUMP.p_ucCOMM_RXPending)
+    #define vCOMM_SendLinkStatus                (BOOT_JUMP.p_vCOMM_SendLinkStatus)
+    #define vBOOT_Run                           (BOOT_JUMP.p_vBOOT_Run)
+    #define ucCOMM_IsRunning                    (BOOT_JUMP.p_ucCOMM_IsRunning)
+  #endif
+
+#endif /*BOOT_H_*/
+//! @}
+//! @}
@@ -1,169 +1,313 @@
-///////////////////////////////////////////////////////////////////////////////
-//! \file changeable_core_header.h
-//! \brief The header file for the core that a user is allowed to change and
-//!	adjust settings.
-//!
-//! This file is where SP transducer files can be included, packet size chosen,
-//! the ID is set, the Label is set, and the transducer functions are declared
-//! and set in the core.
-//!
-//! @addtogroup core
-//! @{
-//!
-//! @addtogroup hdr Core Changeable Header
-//! This is the header file that should be adjusted so the core can be used
-//! with any SP Board transducer functions.
-//! @{
-///////////////////////////////////////////////////////////////////////////////
-//*****************************************************************************
-// By: Samuel Boegli
-//     Wireless Networks Research Lab
-//     Dept of Electrical Engineering, CEFNS
-//     Northern Arizona University
-//
-//*****************************************************************************
-
-#ifndef CHANGEABLE_CORE_HEADER_H_
-#define CHANGEABLE_CORE_HEADER_H_
-
-//includes
-  #include "../UART/uartCom.h" //Comment this out in final code.
-  #include "../Valve/valve.h"
-  #include "../FiveTM/FiveTM.h"
-
-
-//! @name SP Board Software Version Variable
-//!
-//! @{
-//!\def SOFTWAREVERSION
-//! \brief The software version running on the SP Board. Not the Core version.
-#define SOFTWAREVERSION "SP-CM-STM v2.00 "
-//! @}
-
-//! @name Core Property Set Variables
-//! These variables are used to set properties of the core.
-//! @{
-//!\def PACKET_SIZE_128
-//! \brief Chooses whether the data packet uses 128 bits or 32 bits of data
-//!
-//! 128 bit or 32 bit data return packet?
-//!
-//! If you want a 128 bit data size packet, define as: 1
-//!
-//! If you want a 32 bit data size packet, define as: 0
-#define SP_PACKET_SIZE_128		1
-
-//!@}
-
-//! @name SP Board ID Variables
-//! These variables are used to set the unique ID of the SP Board. Should
-//! indicate what type of SP Board it is, what size of data packet it sends,
-//! and have the unique hardware ID in it.
-//! @{
-
-#define  ID_PKT_HI_BYTE1	0x12;
-#define  ID_PKT_LO_BYTE1	0x8B;
-#define  ID_PKT_HI_BYTE2	0x12;
-#define  ID_PKT_LO_BYTE2	0x8B;
-
-//!@}
-
-//! @name Transducer Labels
-//! The labels for each transducer are set in constants here.
-//! Each constant must be 16 characters long.
-//! @{
-#define TRANSDUCER_0_LABEL_TXT "Test Function   " //0000
-#define TRANSDUCER_1_LABEL_TXT "STM1            " //0001
-#define TRANSDUCER_2_LABEL_TXT "STM2            " //0010
-#define TRANSDUCER_3_LABEL_TXT "STM12           " //0011
-#define TRANSDUCER_4_LABEL_TXT "CM1             " //0100
-#define TRANSDUCER_5_LABEL_TXT "CM1 STM1        " //0101
-#define TRANSDUCER_6_LABEL_TXT "CM1 STM2        " //0110
-#define TRANSDUCER_7_LABEL_TXT "CM1 STM12       " //0111
-#define TRANSDUCER_8_LABEL_TXT "CM2             " //1000
-#define TRANSDUCER_9_LABEL_TXT "CM2 STM1        " //1001
-#define TRANSDUCER_A_LABEL_TXT "CM2 STM2        " //1010
-#define TRANSDUCER_B_LABEL_TXT "CM2 STM12       " //1011
-#define TRANSDUCER_C_LABEL_TXT "CM12            " //1100
-#define TRANSDUCER_D_LABEL_TXT "CM12 STM1       " //1101
-#define TRANSDUCER_E_LABEL_TXT "CM12 STM2       " //1110
-#define TRANSDUCER_F_LABEL_TXT "CM12 STM12      " //1111
-
-//!@}
-
-//! @name Transducer Function Declarations
-//! The transducer functions are declared here. They wil be defined in
-//! the main file.
-//!
-//! Every function must be of the format "uint16 FunctionName(uint16 *);"
-//! @{
-
-uint16 main_Test(uint16 *);
-uint16 main_STM1(uint16 *);
-uint16 main_STM2(uint16 *);
-uint16 main_STM12(uint16 *);
-uint16 main_CM1(uint16 *);
-uint16 main_CM1_STM1(uint16 *);
-uint16 main_CM1_STM2(uint16 *);
-uint16 main_CM1_STM12(uint16 *);
-uint16 main_CM2(uint16 *);
-uint16 main_CM2_STM1(uint16 *);
-uint16 main_CM2_STM2(uint16 *);
-uint16 main_CM2_STM12(uint16 *);
-uint16 main_CM12(uint16 *);
-uint16 main_CM12_STM1(uint16 *);
-uint16 main_CM12_STM2(uint16 *);
-uint16 main_CM12_STM12(uint16 *);
-
-//!@}
-
-//! @name Transducer Function Matching
-//! The transducer functions are matched to their respective transducer.
-//! if there is no function for a transducer, the definition NULL shall be used.
-//!
-//! Example:
-//! '#define 	TRANSDUCER_X_FUNCTION 		&FunctionName'
-//!
-//! @{
-
-#define 	TRANSDUCER_0_FUNCTION 		&main_Test
-#define 	TRANSDUCER_1_FUNCTION 		&main_STM1
-#define 	TRANSDUCER_2_FUNCTION 		&main_STM2
-#define 	TRANSDUCER_3_FUNCTION 		&main_STM12
-#define 	TRANSDUCER_4_FUNCTION 		&main_CM1
-#define 	TRANSDUCER_5_FUNCTION 		&main_CM1_STM1
-#define 	TRANSDUCER_6_FUNCTION 		&main_CM1_STM2
-#define 	TRANSDUCER_7_FUNCTION 		&main_CM1_STM12
-#define 	TRANSDUCER_8_FUNCTION 		&main_CM2
-#define 	TRANSDUCER_9_FUNCTION 		&main_CM2_STM1
-#define 	TRANSDUCER_A_FUNCTION 		&main_CM2_STM2
-#define 	TRANSDUCER_B_FUNCTION 		&main_CM2_STM12
-#define 	TRANSDUCER_C_FUNCTION 		&main_CM12
-#define 	TRANSDUCER_D_FUNCTION 		&main_CM12_STM1
-#define 	TRANSDUCER_E_FUNCTION 		&main_CM12_STM2
-#define 	TRANSDUCER_F_FUNCTION 		&main_CM12_STM12
-
-//!@}
-
-//! @name I/O Port Setups
-//! In some cases the I/O Ports must be defined by the Application Layer
-//! Make those defines here. If no change is needed, use 'DEF'
-//!
-//! @{
-#define		DEF			0x100	//Default Statement. Let the core do standard definitions.
-#define 	CoreP1DIR	(~(c5TM_1_RX_PIN + c5TM_2_RX_PIN + DRV_nFAULT))//0xE3	//5TM Inputs must not be Low-Outputs. Also, DRV-nFAULT is an input and must also not be pulled low.
-#define 	CoreP1OUT	DEF
-#define 	CoreP2DIR	DEF
-#define 	CoreP2OUT	DEF
-#define 	CoreP3DIR	DEF
-#define 	CoreP3OUT	DEF
-#define 	CoreP4DIR	DEF
-#define 	CoreP4OUT	DEF
-#define 	CoreP5DIR	DEF
-#define 	CoreP5OUT	DEF
-#define 	CoreP6DIR	DEF
-#define 	CoreP6OUT	DEF
-//!@}
-
-#endif /* CHANGEABLE_CORE_HEADER_H_ */
-
+///////////////////////////////////////////////////////////////////////////////
+//! \file changeable_core_header.h
+//! \brief The header file for the core that a user is allowed to change and
+//!	adjust settings.
+//!
+//! This file is where SP transducer files can be included, packet size chosen,
+//! the ID is set, the Label is set, and the transducer functions are declared
+//! and set in the core.
+//!
+//! @addtogroup core
+//! @{
+//!
+//! @addtogroup hdr Core Changeable Header
+//! This is the header file that should be adjusted so the core can be used
+//! with any SP Board transducer functions.
+//! @{
+///////////////////////////////////////////////////////////////////////////////
+//*****************************************************************************
+// By: Samuel Boegli
+//     Wireless Networks Research Lab
+//     Dept of Electrical Engineering, CEFNS
+//     Northern Arizona University
+//
+//*****************************************************************************
+
+#ifndef CHANGEABLE_CORE_HEADER_H_
+#define CHANGEABLE_CORE_HEADER_H_
+
+//includes
+  #include "../UART/uartCom.h" //Comment this out in final code.
+  #include "../Valve/valve.h"
+  #include "../FiveTM/FiveTM.h"
+
+
+//! @name SP Board Software Version Variable
+//!
+//! @{
+//!\def SOFTWAREVERSION
+//! \brief The software version running on the SP Board. Not the Core version.
+#define SOFTWAREVERSION "SP-CM-STM v2.00 "
+//! @}
+
+//! @name Core Property Set Variables
+//! These variables are used to set properties of the core.
+//! @{
+//!\def PACKET_SIZE_128
+//! \brief Chooses whether the data packet uses 128 bits or 32 bits of data
+//!
+//! 128 bit or 32 bit data return packet?
+//!
+//! If you want a 128 bit data size packet, define as: 1
+//!
+//! If you want a 32 bit data size packet, define as: 0
+#define SP_PACKET_SIZE_128		1
+
+//!\def SP_PACKET_VARIABLE
+//! \brief Chooses whether data reports leave out the data words that are 0
+//!
+//! If you want REQUEST_DATA answered with a REPORT_VAR_DATA (or
+//! REPORT_VAR_ERROR) that only carries the data words that are not 0,
+//! define as: 1. This takes the place of SP_PACKET_SIZE_128 for the reports.
+//!
+//! If you want the fixed size REPORT_DATA, define as: 0
+#define SP_PACKET_VARIABLE		0
+
+//!\def SP_PACKET_PACKED_5TM
+//! \brief Chooses whether the 5TM and valve results are bit-packed
+//!
+//! If you want each 5TM and its valve reported as one 32 bit record, define
+//! as: 1. The record of 5TM n and valve n is in data words 2n+3 and 2n+4
+//! (data5/data6 and data7/data8), the other words are 0. The first word holds
+//! the 5TM status in bits 15-14, the valve status in bits 13-12 (0 not run,
+//! 1 ok, 2 checksum error or fault before, 3 timeout or fault after) and
+//! the raw soil moisture in bits 11-0, half the usual value. The second word
+//! holds the temperature * 10 in bits 15-4, as a signed 12 bit number. Used
+//! with SP_PACKET_VARIABLE, both records take 8 bytes of the report.
+//!
+//! If you want the soil moisture, temperature and error codes as separate
+//! data words, define as: 0
+#define SP_PACKET_PACKED_5TM	0
+
+//!\def SP_VALVES_TOGETHER
+//! \brief Chooses whether both valves are set with one pulse
+//!
+//! If you want a transducer that sets both valves to power both H-Bridges
+//! at once, define as: 1. This saves one ONOFF_CYCLE but draws twice the
+//! current, and a fault is reported for both valves.
+//!
+//! If you want the valves set one after the other, define as: 0
+#define SP_VALVES_TOGETHER		0
+
+//!\def SP_REPORT_BY_EXCEPTION
+//! \brief Chooses whether unchanged readings get a short answer
+//!
+//! If you want a deadband per transducer, set with SET_DEADBAND_PKT, define
+//! as: 1. A REQUEST_DATA is then answered with a REPORT_NO_CHANGE when no
+//! data word moved by more than the deadband since the last report that was
+//! sent. Errors are always reported in full. This takes 18 bytes of RAM per
+//! transducer. Use it with SP_COMM_FRAMED, so a lost report is sent again
+//! instead of being taken as no change. Does not work with
+//! SP_PACKET_PACKED_5TM.
+//!
+//! If you want every REQUEST_DATA answered with the full report, define
+//! as: 0
+#define SP_REPORT_BY_EXCEPTION	0
+
+//!\def SP_COMM_FULL_DUPLEX
+//! \brief Chooses whether the CP link can send and receive at the same time
+//!
+//! If you want TX on TACCR1 and RX on TACCR0, so a reply can start while the
+//! CP is still sending, define as: 1
+//!
+//! If you want TX and RX to share TACCR0, with the TX bit edges set by the
+//! Out0 output unit, define as: 0
+#define SP_COMM_FULL_DUPLEX		0
+
+//!\def SP_COMM_FRAMED
+//! \brief Chooses whether messages on the CP link are framed
+//!
+//! If you want every message sent with a sync byte, length and CRC-16, with
+//! corrupt frames dropped and NAKed, define as: 1
+//!
+//! If you want the bare messages of the original protocol, define as: 0
+#define SP_COMM_FRAMED			0
+
+//!\def SP_COMM_AUTOBAUD
+//! \brief Chooses whether the CP link baud rate is measured at start up
+//!
+//! If you want the SP Board to time the first byte from the CP Board and
+//! run at whatever rate it uses, define as: 1. The CP Board must then talk
+//! first: the ID_PKT is sent in answer to its first HAND_SHK.
+//!
+//! If you want the fixed rate passed to vCOMM_Init(), define as: 0
+#define SP_COMM_AUTOBAUD		0
+
+//!\def SP_COMM_ADDRESSED
+//! \brief Chooses whether several SP Boards share one CP link
+//!
+//! If you want frames to carry an address, so several SP Boards can hang
+//! off one CP Board serial port, define as: 1. The address of the SP Board
+//! is ID_PKT_HI_BYTE1 and ID_PKT_LO_BYTE1, which must then be unique on the
+//! line and not 0xFFFF. Frames for other addresses are dropped, corrupt
+//! frames are not NAKed and the TX pin is only driven while a message goes
+//! out, so the TX line needs a pull up. The CP Board must talk first, as
+//! with SP_COMM_AUTOBAUD. Needs SP_COMM_FRAMED.
+//!
+//! If you want one SP Board on the CP link, define as: 0
+#define SP_COMM_ADDRESSED		0
+
+//!\def SP_COMM_LATENCY_STATS
+//! \brief Chooses whether the CP link ISRs time how late they run
+//!
+//! If you want the worst ISR latency in data8 of the REPORT_LINK_STATUS,
+//! at the cost of a few cycles on every bit, define as: 1
+//!
+//! If you want data8 left at 0, define as: 0
+#define SP_COMM_LATENCY_STATS	0
+
+//!\def SP_SMCLK_16MHZ
+//! \brief Chooses the SMCLK frequency, which clocks the CP link timer
+//!
+//! If you want the SMCLK at the full 16 MHz of the DCO, so the CP link bit
+//! edges land within 1/16 us of where they should, define as: 1. Timer B is
+//! divided down to 4 MHz for the 5TM driver, but the slowest rate autobaud
+//! can measure goes up to about 2000 baud.
+//!
+//! If you want the SMCLK at DCO / 4 = 4 MHz, define as: 0
+#define SP_SMCLK_16MHZ			0
+
+//!\def SP_IDLE_LPM4
+//! \brief Chooses the low power mode the SP Board idles in between requests
+//!
+//! If you want the SP Board to idle in LPM4, with the ACLK, the DCO and all
+//! timers stopped, define as: 1. The CP Board must then send SP_WAKE_BYTE
+//! ahead of every request, since the first byte may be lost while the DCO
+//! starts. The debug UART cannot wake the SP Board in LPM4. If Timer B is
+//! still running when the core goes idle it falls back to LPM3.
+//!
+//! If you want the SP Board to idle in LPM3, so the ACLK keeps running,
+//! define as: 0
+#define SP_IDLE_LPM4			0
+
+//!\def SP_FIRMWARE_UPDATE
+//! \brief Chooses whether the application can be rewritten over the CP link
+//!
+//! If you want the CP Board to be able to send a new application image
+//! (see \ref msg_update), define as: 1. The update runs at the link rate in
+//! use when the UPDATE_START_PKT comes in, so the CP Board should change to
+//! its fastest rate first. The firmware is then linked twice (see
+//! \ref boot): boot.c and comm.c with lnk_msp430f235_boot.cmd into the 4 kB
+//! BOOT area, which is programmed once, and the other sources with
+//! lnk_msp430f235_app.cmd into the image an update sends. The BOOT link
+//! keeps 384 bytes of RAM to itself. An image only goes on a board whose
+//! BOOT area was built with the same switches. Needs SP_COMM_FRAMED.
+//!
+//! If you want the application to be programmed over JTAG or BSL only,
+//! define as: 0
+#define SP_FIRMWARE_UPDATE		0
+
+//!@}
+
+//! @name SP Board ID Variables
+//! These variables are used to set the unique ID of the SP Board. Should
+//! indicate what type of SP Board it is, what size of data packet it sends,
+//! and have the unique hardware ID in it.
+//! @{
+
+#define  ID_PKT_HI_BYTE1	0x12
+#define  ID_PKT_LO_BYTE1	0x8B
+#define  ID_PKT_HI_BYTE2	0x12
+#define  ID_PKT_LO_BYTE2	0x8B
+
+//!@}
+
+//! @name Transducer Labels
+//! The labels for each transducer are set in constants here.
+//! Each constant must be 16 characters long.
+//! @{
+#define TRANSDUCER_0_LABEL_TXT "Test Function   " //0000
+#define TRANSDUCER_1_LABEL_TXT "STM1            " //0001
+#define TRANSDUCER_2_LABEL_TXT "STM2            " //0010
+#define TRANSDUCER_3_LABEL_TXT "STM12           " //0011
+#define TRANSDUCER_4_LABEL_TXT "CM1             " //0100
+#define TRANSDUCER_5_LABEL_TXT "CM1 STM1        " //0101
+#define TRANSDUCER_6_LABEL_TXT "CM1 STM2        " //0110
+#define TRANSDUCER_7_LABEL_TXT "CM1 STM12       " //0111
+#define TRANSDUCER_8_LABEL_TXT "CM2             " //1000
+#define TRANSDUCER_9_LABEL_TXT "CM2 STM1        " //1001
+#define TRANSDUCER_A_LABEL_TXT "CM2 STM2        " //1010
+#define TRANSDUCER_B_LABEL_TXT "CM2 STM12       " //1011
+#define TRANSDUCER_C_LABEL_TXT "CM12            " //1100
+#define TRANSDUCER_D_LABEL_TXT "CM12 STM1       " //1101
+#define TRANSDUCER_E_LABEL_TXT "CM12 STM2       " //1110
+#define TRANSDUCER_F_LABEL_TXT "CM12 STM12      " //1111
+
+//!@}
+
+//! @name Transducer Function Declarations
+//! The transducer functions are declared here. They wil be defined in
+//! the main file.
+//!
+//! Every function must be of the format "uint16 FunctionName(uint16 *);"
+//! @{
+
+uint16 main_Test(uint16 *);
+uint16 main_STM1(uint16 *);
+uint16 main_STM2(uint16 *);
+uint16 main_STM12(uint16 *);
+uint16 main_CM1(uint16 *);
+uint16 main_CM1_STM1(uint16 *);
+uint16 main_CM1_STM2(uint16 *);
+uint16 main_CM1_STM12(uint16 *);
+uint16 main_CM2(uint16 *);
+uint16 main_CM2_STM1(uint16 *);
+uint16 main_CM2_STM2(uint16 *);
+uint16 main_CM2_STM12(uint16 *);
+uint16 main_CM12(uint16 *);
+uint16 main_CM12_STM1(uint16 *);
+uint16 main_CM12_STM2(uint16 *);
+uint16 main_CM12_STM12(uint16 *);
+
+//!@}
+
+//! @name Transducer Function Matching
+//! The transducer functions are matched to their respective transducer.
+//! if there is no function for a transducer, the definition NULL shall be used.
+//!
+//! Example:
+//! '#define 	TRANSDUCER_X_FUNCTION 		&FunctionName'
+//!
+//! @{
+
+#define 	TRANSDUCER_0_FUNCTION 		&main_Test
+#define 	TRANSDUCER_1_FUNCTION 		&main_STM1
+#define 	TRANSDUCER_2_FUNCTION 		&main_STM2
+#define 	TRANSDUCER_3_FUNCTION 		&main_STM12
+#define 	TRANSDUCER_4_FUNCTION 		&main_CM1
+#define 	TRANSDUCER_5_FUNCTION 		&main_CM1_STM1
+#define 	TRANSDUCER_6_FUNCTION 		&main_CM1_STM2
+#define 	TRANSDUCER_7_FUNCTION 		&main_CM1_STM12
+#define 	TRANSDUCER_8_FUNCTION 		&main_CM2
+#define 	TRANSDUCER_9_FUNCTION 		&main_CM2_STM1
+#define 	TRANSDUCER_A_FUNCTION 		&main_CM2_STM2
+#define 	TRANSDUCER_B_FUNCTION 		&main_CM2_STM12
+#define 	TRANSDUCER_C_FUNCTION 		&main_CM12
+#define 	TRANSDUCER_D_FUNCTION 		&main_CM12_STM1
+#define 	TRANSDUCER_E_FUNCTION 		&main_CM12_STM2
+#define 	TRANSDUCER_F_FUNCTION 		&main_CM12_STM12
+
+//!@}
+
+//! @name I/O Port Setups
+//! In some cases the I/O Ports must be defined by the Application Layer
+//! Make those defines here. If no change is needed, use 'DEF'
+//!
+//! @{
+#define		DEF			0x100	//Default Statement. Let the core do standard definitions.
+#define 	CoreP1DIR	(~(c5TM_1_RX_PIN + c5TM_2_RX_PIN + DRV_nFAULT))//0xE3	//5TM Inputs must not be Low-Outputs. Also, DRV-nFAULT is an input and must also not be pulled low.
+#define 	CoreP1OUT	DEF
+#define 	CoreP2DIR	DEF
+#define 	CoreP2OUT	DEF
+#define 	CoreP3DIR	DEF
+#define 	CoreP3OUT	DEF
+#define 	CoreP4DIR	DEF
+#define 	CoreP4OUT	DEF
+#define 	CoreP5DIR	DEF
+#define 	CoreP5OUT	DEF
+#define 	CoreP6DIR	DEF
+#define 	CoreP6OUT	DEF
+//!@}
+
+#endif /* CHANGEABLE_CORE_HEADER_H_ */
+
@@ -1,732 +1,2083 @@
-///////////////////////////////////////////////////////////////////////////////
-//! \file comm.c
-//! \brief This modules implements a software UART on any two Digital I/O pins
-//!
-//! This module uses TimerA to implement a software UART on any two defined
-//! digital I/O pin. Note that the RX pin must also be interrupt capable.
-//!
-//! @addtogroup core
-//! @{
-//!
-//! @addtogroup comm Software UART
-//! The software UART module allows the user to define a UART interface on
-//! any two GPIO pins, provided that the RX pin is interrupt capable. The
-//! module requires the use of TimerA.
-//! @{
-///////////////////////////////////////////////////////////////////////////////
-//*****************************************************************************
-// By: Kenji Yamamoto
-//     Wirless Networks Research Lab
-//     Dept of Electrical Engineering, CEFNS
-//     Northern Arizona University
-//*****************************************************************************
-
-#include <msp430x23x.h>
-#include "../core.h"
-
-//******************  Pin Configurations  ***********************************//
-// Defines for the TX pin (currently 1.1)
-//! @name Pin Defines
-//! These defines are used so that the software has the right hardware
-//! registers for the TX and RX pins.
-//! @{
-//! \def TX_PIN
-//! \brief The pin number of the TX pin (BIT0 to BIT7)
-#define TX_PIN          BIT1
-//! \def P_TX_OUT
-//! \brief The PxOUT register that the TX pin is on
-#define P_TX_OUT        P1OUT
-//! \def P_TX_DIR
-//! \brief The PxDIR register that the TX pin is on
-#define P_TX_DIR        P1DIR
-
-// Defines for the RX pin (currently 2.2)
-//! \def RX_PIN
-//! \brief The pin number of the RX pin (BIT0 to BIT7)
-#define RX_PIN          BIT2
-//! \def P_RX_DIR
-//! \brief The PxDIR register of the RX pin
-#define P_RX_DIR        P2DIR
-//! \def P_RX_IN
-//! \brief The PxIN register of the RX pin
-#define P_RX_IN         P2IN
-//! \def P_RX_IES
-//! \brief The PxIES register of the RX pin
-#define P_RX_IES        P2IES
-//! \def P_RX_IFG
-//! \brief The PxIFG register of the RX pin
-#define P_RX_IFG        P2IFG
-//! \def P_RX_IE
-//! \brief The PxIE register of the RX pin
-#define P_RX_IE         P2IE
-
-// Define for the Interrupt pin (currently 2.0)
-//! \def INT_PIN
-//! \brief The pin number of the INT pin (BIT0 to BIT7)
-#define INT_PIN          BIT0
-//! @}
-
-
-
-//******************  Control and Indication Variables  *********************//
-//! @name Control and Indication Variables
-//! These variables are used to indicate to the system the current status
-//! of the \ref comm Module and to store the baud rate timer information.
-//! @{
-//! \var volatile uint8 g_ucCOMM_Flags
-//! \brief This 8-bit field indicates the status of the COMM module.
-volatile uint8 g_ucCOMM_Flags;
-
-//! \var uint16 g_unCOMM_BaudRateControl
-//! \brief This is the value used to control the baud rate.
-//!
-//! This value is the number of timer ticks corresponding to one bit period
-//! for the baud rate. It should be set from the \ref comm_baud
-//! "Baud Rate Defines".
-uint16 g_unCOMM_BaudRateControl;
-
-//! \var uint16 g_unCOMM_BaudRateDelayControl
-//! \brief This is the value used to delay from the start bit
-//!
-//! This value is the number of timer ticks to wait from the beginning of the
-//! start bit to the middle of the first data bit. It should be set from the
-//! \ref comm_baud_delay "Baud Rate Start Delays".
-uint16 g_unCOMM_BaudRateDelayControl;
-//! @}
-
-//******************  RX Variables  *****************************************//
-//! @name Receive Variables
-//! These variables are used in the receiving of data on the \ref comm Module.
-//! @{
-//! \var volatile uint8 g_ucaRXBuffer[RX_BUFFER_SIZE]
-//! \brief The software UART RX Buffer
-volatile uint8 g_ucaRXBuffer[RX_BUFFER_SIZE];
-
-//! \var volatile uint8 g_ucRXBufferIndex
-//! \brief This index into g_ucaRXBuffer showing the current write position.
-volatile uint8 g_ucRXBufferIndex;
-
-//! \var uint8 g_ucRXBitsLeft
-//! \brief The number of bits left to be received for the current byte.
-uint8 g_ucRXBitsLeft;
-//! @}
-
-//******************  TX Variables  *****************************************//
-//! @name Transmit Variables
-//! There variables are used in the transmitting of data on the \ref comm
-//! Module.
-//! @{
-//! \var uint8 g_ucTXBuffer
-//! \brief The current byte being transmitted by the software.
-uint8 g_ucTXBuffer;
-
-//! \var uint8 g_ucTXBitsLeft
-//! \brief The number of bits left to be transmitted for the current byte.
-uint8 g_ucTXBitsLeft;
-//! @}
-
-
-
-//******************  Functions  ********************************************//
-///////////////////////////////////////////////////////////////////////////////
-//! \brief This sets up the hardware resources for doing software UART
-//!
-//! Since we are doing UART without the USCI, we use TimerA and it's interrupt
-//! to control the baud rate. The TX and RX pins are completely controllable
-//! at compile time. The software UART expects 1 start bit, 8 data bits and
-//! 1 stop bit.
-//!
-//! To ensure correct operation of the software UART, the \ref comm_pins
-//! "Comm Pin Defines" must be set correctly.
-//!   \param ucBaud The baud rate define to use
-//!   \return None
-//!   \sa vCOMM_SendByte(), TIMERA0_ISR()
-///////////////////////////////////////////////////////////////////////////////
-void vCOMM_Init(uint16 ucBaud)
-{
-  // We set the directionality of the TX and RX pins based on the defines
-  P_TX_DIR |= TX_PIN;
-  P_RX_DIR &= ~RX_PIN;
-
-  // Idle state for UART is high, so take the TX high
-  P_TX_OUT |= TX_PIN;
-
-  // Clear the RX buffer and reset index
-  for (g_ucRXBufferIndex = 0x00;
-       g_ucRXBufferIndex < RX_BUFFER_SIZE;
-       g_ucRXBufferIndex++)
-  {
-    g_ucaRXBuffer[g_ucRXBufferIndex] = 0xFF;
-  }
-  g_ucRXBufferIndex = 0x00;
-
-  // Enable the falling edge interrupt on RX to see start bits
-  P_RX_IES |= RX_PIN;
-  P_RX_IFG &= ~RX_PIN;
-  P_RX_IE  |= RX_PIN;
-
-  // BUG FIX: Clear TACTL in case someone was using it before us
-  TACTL = 0x0000;
-
-  // Hold TimerA in reset
-  TACTL &= ~(MC0 | MC1);
-
-  // Use the SMCLK, enable CCR0 interrupt
-  TACTL |= TASSEL_2;
-  TACCTL0 |= CCIE;
-
-  // The timer interrupt controls the baud rate, currently configured for a
-  // 4 MHz SMCLK
-  g_unCOMM_BaudRateControl = ucBaud;
-  switch(g_unCOMM_BaudRateControl)
-  {
-  	case BAUD_1200:
-      g_unCOMM_BaudRateDelayControl = BAUD_1200_DELAY;
-      break;
-
-    case BAUD_9600:
-      g_unCOMM_BaudRateDelayControl = BAUD_9600_DELAY;
-      break;
-
-    case BAUD_19200:
-      g_unCOMM_BaudRateDelayControl = BAUD_19200_DELAY;
-      break;
-
-    case BAUD_57600:
-      g_unCOMM_BaudRateDelayControl = BAUD_57600_DELAY;
-      break;
-
-    case BAUD_115200:
-      g_unCOMM_BaudRateDelayControl = BAUD_115200_DELAY;
-      break;
-
-	case BAUD_230400:
-      g_unCOMM_BaudRateDelayControl = BAUD_230400_DELAY;
-      break;
-
-  	case BAUD_345600:
-      g_unCOMM_BaudRateDelayControl = BAUD_345600_DELAY;
-      break;
-
-  	case BAUD_460800:
-      g_unCOMM_BaudRateDelayControl = BAUD_460800_DELAY;
-      break;
-
-    default:
-      g_unCOMM_BaudRateControl = BAUD_9600;
-      g_unCOMM_BaudRateDelayControl = BAUD_9600_DELAY;
-      break;
-  }
-
-  TACCR0 = g_unCOMM_BaudRateControl;
-
-  g_ucCOMM_Flags = COMM_RUNNING;
-}
-
-///////////////////////////////////////////////////////////////////////////////
-//! \brief Sends a byte via the software UART
-//!
-//! This function pushes \e ucChar into the global TX buffer, where the
-//! TimerA ISR can access it. The system drops into LPM0, keeping the SMCLK
-//! alive for TimerA. The ISR handles the start and stop bits as well as the
-//! baud rate. This is a blocking call and will not return until the software
-//! has sent the entire message.
-//!   \param ucChar The 8-bit value to send
-//!   \return None
-//!   \sa TIMERA0_ISR(), vCOMM_Init()
-///////////////////////////////////////////////////////////////////////////////
-void vCOMM_SendByte(uint8 ucChar)
-{
-  // If we are already busy, return so as not to screw it up
-  if(g_ucCOMM_Flags & COMM_TX_BUSY)
-    return;
-
-  // Indicate in the status register that we are now busy
-  g_ucCOMM_Flags |= COMM_TX_BUSY;
-
-  // Push the value to the global TX buffer
-  g_ucTXBuffer = ucChar;
-
-  // Reset the bit count so the ISR knows how many bits left to send
-  g_ucTXBitsLeft = 0x0A;
-
-  TA0CCR0 = g_unCOMM_BaudRateControl;
-  // Starts the counter in 'Up-Mode'
-  TACTL |= TACLR | MC_1;
-
-  // Shutoff the MCLK, execution returns here after TX is done
-  __bis_SR_register(GIE + LPM0_bits);
-
-  // Stop the timer and show we are done
-  TACTL &= ~(MC0 | MC1 | TAIFG);
-  g_ucCOMM_Flags &= ~COMM_TX_BUSY;
-}
-
-///////////////////////////////////////////////////////////////////////////////
-//! \brief Shuts off the software modules
-//!
-//! This shuts down TimerA and disables all of the interrupts used
-//!   \param None
-//!   \return None
-//!   \sa vCOMM_Init()
-///////////////////////////////////////////////////////////////////////////////
-void vCOMM_Shutdown(void)
-{
-  // Halt timer and clear interrupt enables
-  TACTL &= ~(MC0 | MC1 | TAIE | TAIFG);
-  TACCTL0 &= ~CCIE;
-
-  // Disable RX interrupt
-  P_RX_IE &= ~RX_PIN;
-  g_ucCOMM_Flags &= ~COMM_RUNNING;
-
-  //Let TX drop
-  P_TX_OUT &= ~TX_PIN;
-}
-
-///////////////////////////////////////////////////////////////////////////////
-//! \brief Waits for reception of a data message
-//!
-//! This function waits for a data message to be recieved on the serial port.
-//! Technically, it waits for the correct number of packets corresponding to a
-//! a data message, but since we control both sides of the link and the
-//! protocol flow, we can get away with it.
-//!   \param None.
-//!   \return None.
-///////////////////////////////////////////////////////////////////////////////
-void vCOMM_WaitFor32BitDataMessage(void)
-{
-  //__bis_SR_register(LPM3_bits); //CPU asleep and all clocks except ACLK asleep.
-  //ACLK must stay on because valves may need it. If either UART has a byte or
-  //we get a start bit from the CP-board, we leave this and check if we have
-  // a complete message from CP. Then it waits for complete message (needs LPM0
-  //so we can receive message from CP-board). I wanted the UART to be checked
-  //inside this while loop in case a start bit comes while UART is being handled.
-  //(Danger of re-entering LMP3 while SMCLK timer is needed)
-  //A better code could be written with flags etc, but UART is only used in test
-  //environment so this is not OP critical.
-
-  while (g_ucRXBufferIndex != SP_32BITDATAMESSAGE_SIZE){
-	  //UARTDELETE
-	  if(ucUARTCOM_getBufferFill() &&ucUARTCOM_LastIsReturn()){//Can comment this out when final code published.
-		  vUARTCOM_HandleUART();
-	  }
-	  __bis_SR_register(LPM0_bits); //CPU asleep.
-  }
-}
-
-///////////////////////////////////////////////////////////////////////////////
-//! \brief Waits for reception of a data message
-//!
-//! This function waits for a data message to be recieved on the serial port.
-//! Technically, it waits for the correct number of packets corresponding to a
-//! a data message, but since we control both sides of the link and the
-//! protocol flow, we can get away with it.
-//!   \param None.
-//!   \return None.
-///////////////////////////////////////////////////////////////////////////////
-void vCOMM_WaitFor128BitDataMessage(void)
-{
-
-
-  while (g_ucRXBufferIndex != SP_128BITDATAMESSAGE_SIZE){
-	  __bis_SR_register(LPM0_bits); //CPU asleep.
-  }
-}
-
-///////////////////////////////////////////////////////////////////////////////
-//! \brief Waits for reception of a label message
-//!
-//! This function waits for a label message to be received on the serial port.
-//! Technically, it waits for the correct number of packets corresponding to a
-//! a label message, but since we control both sides of the link and the
-//! protocol flow, we can get away with it.
-//!   \param None.
-//!   \return None.
-///////////////////////////////////////////////////////////////////////////////
-void vCOMM_WaitForLabelMessage(void)
-{
-  while (g_ucRXBufferIndex != SP_LABELMESSAGE_SIZE){
-
-
-
-  }
-}
-
-///////////////////////////////////////////////////////////////////////////////
-//! \brief Sends a data message on the serial port
-//!
-//! This function sends the data message pointed to by \e p_DataMessage on the
-//! software UART line
-//!   \param p_DataMessage Pointer to the message to send
-//!   \return None
-///////////////////////////////////////////////////////////////////////////////.
-void vCOMM_Send32BitDataMessage(union SP_32BitDataMessage * p_32BitDataMessage)
-{
-  uint8 ucLoopCount;
-
-  for (ucLoopCount = 0x00;
-       ucLoopCount < SP_32BITDATAMESSAGE_SIZE;
-       ucLoopCount++)
-    vCOMM_SendByte(p_32BitDataMessage->ucByteStream[ucLoopCount]);
-}
-
-#if SP_PACKET_SIZE_128
-///////////////////////////////////////////////////////////////////////////////
-//! \brief Sends a data return message on the serial port
-//! Written by -scb
-//!
-//! This function sends the data message pointed to by \e p_DataMessage on the
-//! software UART line
-//!   \param p_DataMessage Pointer to the message to send
-//!   \return None
-///////////////////////////////////////////////////////////////////////////////
-
-void vCOMM_Send128BitDataMessage(union SP_128BitDataMessage * p_128BitDataMessage)
-{
-  uint8 ucLoopCount;
-  for (ucLoopCount = 0x00;
-       ucLoopCount < SP_128BITDATAMESSAGE_SIZE;//size is 160 bit (128 + 32)
-       ucLoopCount++)
-    vCOMM_SendByte(p_128BitDataMessage->ucByteStream[ucLoopCount]);
-}
-#endif
-///////////////////////////////////////////////////////////////////////////////
-//! \brief Sends a label message on the serial port
-//!
-//! This function sends the label message pointed to by \e p_LabelMessage on
-//! the software UART line
-//!   \param p_LabelMessage Pointer to the message to send
-//!   \return None.
-///////////////////////////////////////////////////////////////////////////////
-void vCOMM_SendLabelMessage(union SP_LabelMessage * p_LabelMessage)
-{
-  uint8 ucLoopCount;
-
-  for (ucLoopCount = 0x00;
-       ucLoopCount < SP_LABELMESSAGE_SIZE;
-       ucLoopCount++)
-    vCOMM_SendByte(p_LabelMessage->ucByteStream[ucLoopCount]);
-}
-
-
-///////////////////////////////////////////////////////////////////////////////
-//! \brief Grabs the raw chars from buffer and formats into a data message
-//!
-//! This function takes the characters from \e g_ucaRXBuffer and formats and
-//! stores them in the data message pointed to by \e message.
-//!   \param message Pointer to the message
-//!   \return The error code indicating the status after call
-//!   \sa comm.h msg.h
-///////////////////////////////////////////////////////////////////////////////
-uint8 ucCOMM_Grab32BitDataMessageFromBuffer(union SP_32BitDataMessage * message)
-{
-  uint8 ucLoopCount;
-
-  if (g_ucRXBufferIndex < SP_32BITDATAMESSAGE_SIZE)
-    return COMM_BUFFER_UNDERFLOW;
-
-  for (ucLoopCount = 0x00;
-       ucLoopCount < SP_32BITDATAMESSAGE_SIZE;
-       ucLoopCount++)
-    message->ucByteStream[ucLoopCount] = g_ucaRXBuffer[ucLoopCount];
-
-  g_ucRXBufferIndex = 0x00;
-
-  return COMM_OK;
-}
-
-///////////////////////////////////////////////////////////////////////////////
-//! \brief Grabs the raw chars from buffer and formats into a data message
-//!
-//! This function takes the characters from \e g_ucaRXBuffer and formats and
-//! stores them in the data message pointed to by \e message.
-//!   \param message Pointer to the message
-//!   \return The error code indicating the status after call
-//!   \sa comm.h msg.h
-///////////////////////////////////////////////////////////////////////////////
-uint8 ucCOMM_Grab128BitDataMessageFromBuffer(union SP_128BitDataMessage * message)
-{
-  uint8 ucLoopCount;
-
-  if (g_ucRXBufferIndex < SP_128BITDATAMESSAGE_SIZE)
-    return COMM_BUFFER_UNDERFLOW;
-
-  for (ucLoopCount = 0x00;
-       ucLoopCount < SP_128BITDATAMESSAGE_SIZE;
-       ucLoopCount++)
-    message->ucByteStream[ucLoopCount] = g_ucaRXBuffer[ucLoopCount];
-
-  g_ucRXBufferIndex = 0x00;
-
-  return COMM_OK;
-}
-
-///////////////////////////////////////////////////////////////////////////////
-//! \brief Grabs the raw chars from buffer and formats into a label message
-//!
-//! This function takes the characters from \e g_ucaRXBuffer and formats and
-//! stores them in the label message pointed to by \e message.
-//!   \param message Pointer to the label message
-//!   \return The error code indicatin the status of the call
-//!   \sa comm.h msg.h
-///////////////////////////////////////////////////////////////////////////////
-uint8 ucCOMM_GrabLabelMessageFromBuffer(union SP_LabelMessage * message)
-{
-  uint8 ucLoopCount;
-
-  if (g_ucRXBufferIndex < SP_LABELMESSAGE_SIZE)
-    return COMM_BUFFER_UNDERFLOW;
-
-  for (ucLoopCount = 0x00;
-       ucLoopCount < SP_LABELMESSAGE_SIZE;
-       ucLoopCount++)
-    message->ucByteStream[ucLoopCount] = g_ucaRXBuffer[ucLoopCount];
-
-  g_ucRXBufferIndex = 0x00;
-
-  return COMM_OK;
-}
-
-///////////////////////////////////////////////////////////////////////////////
-//! \brief TimerA0 ISR, sends and receives on the software UART lines
-//!
-//! TimerA has been configured by \e vCOMM_Init() to generate an interrupt
-//! for the bit timing on a specific baud rate. Each time it is called, the
-//! ISR checks to see which bit it is sending, control or data. Then the
-//! appropriate bits are calculated and sent. If there are no more bits to
-//! send, then the ISR returns the system to active mode (AM).
-//!
-//! This ISR handles the timing for both TX and RX. Therefore, it is best to
-//! use this module in half-duplex mode only. Other wise you risk the
-//! possiblity of having a very long ISR, which will kill the delicate UART
-//! timing.
-//!
-//! NOTE: Traditionally an ISR is only used to changed state and not for
-//! for making decisions and changing pins. However, because we are doing
-//! software UART and time was imortant, I wanted to avoid the latency
-//! associated with moving into AND out of an ISR. For future improvements,
-//! see the TODO below.
-//!
-//! TODO: Move the bulk of this code and decision making into the SendByte
-//! routine, only have the ISR perform MCU wake up and state switching for
-//! TX. The RX code has to remain as this is an asynchronous protocol and
-//! packets can come in at any time. These changes may require tweaking of
-//! the UART delay values to ensure that the space and mark timing is
-//! correct.
-//!
-//! NOTE: This interrupt is ONLY for handling CCR0, allowing the user to use
-//! the TIMERA1 interrupt for other uses of TA CCR1, CCR2 and TAIFG
-//!   \param None
-//!   \return None
-//!   \sa vCOMM_Init(), vCOMM_SendByte()
-///////////////////////////////////////////////////////////////////////////////
-#pragma vector=TIMERA0_VECTOR
-__interrupt void TIMERA0_ISR(void)
-{
-  if (g_ucCOMM_Flags & COMM_TX_BUSY)
-  {
-    switch(g_ucTXBitsLeft)
-    {
-      case 0x00:
-        // If there are no bits left, then return to function call
-        __bic_SR_register_on_exit(LPM0_bits);
-        break;
-
-      case 0x01:
-        // Last bit is stop bit, return to idle state
-        P_TX_OUT |= TX_PIN;
-        __bic_SR_register_on_exit(LPM0_bits);
-        break;
-
-      case 0x0A:
-        // First bit is start bit
-        P_TX_OUT &= ~TX_PIN;
-        break;
-
-      default:
-        // For data bits, mask to get correct value and the shift for next time
-        if (g_ucTXBuffer & 0x01)
-          P_TX_OUT |= TX_PIN;
-        else
-          P_TX_OUT &= ~TX_PIN;
-
-        g_ucTXBuffer >>= 1;
-        break;
-    }
-
-    // Decrement the total bit count
-    g_ucTXBitsLeft--;
-  }
-
-  if (g_ucCOMM_Flags & COMM_RX_BUSY)
-  {
-    switch(g_ucRXBitsLeft)
-    {
-      case 0x00:
-        // There are no bits left, so lets reset all the values and stop timer
-        TACTL &= ~(MC0 | MC1);
-        P_RX_IE |= RX_PIN;
-        P_RX_IFG &= ~RX_PIN;
-        g_ucRXBufferIndex++;
-        g_ucCOMM_Flags &= ~COMM_RX_BUSY;
-        //Set All Clocks and CPU etc awake now that we received a byte. (check if it's last later)
-        //If it is not the last Byte, the core will put us back into LPM0, which won't stop the clocks, just the CPU
-        //This does not have to be done here, since we unset the RX flag, the later function will do this for us.
-        break;
-
-      case 0x01:
-        if (P_RX_IN & RX_PIN)
-          g_ucaRXBuffer[g_ucRXBufferIndex] |= 0x80;
-        else
-          g_ucaRXBuffer[g_ucRXBufferIndex] &= ~0x80;
-
-        break;
-
-      default:
-        if (P_RX_IN & RX_PIN)
-          g_ucaRXBuffer[g_ucRXBufferIndex] |= 0x80;
-        else
-          g_ucaRXBuffer[g_ucRXBufferIndex] &= ~0x80;
-
-        g_ucaRXBuffer[g_ucRXBufferIndex] >>= 1;
-        break;
-    }
-    g_ucRXBitsLeft--;
-  }
-
-  if(!(g_ucCOMM_Flags & COMM_RX_BUSY) && !(g_ucCOMM_Flags & COMM_TX_BUSY))
-  {
-	  __bic_SR_register_on_exit(LPM4_bits); //Exit LPM if it was neither RX nor TX
-  }
-
-}
-
-///////////////////////////////////////////////////////////////////////////////
-//! \brief Port2 ISR, handles the start of the UART RX
-//!
-//! The idle state for UART is line high, thus when we get the falling edge
-//! indicating the start bit, we can start the timer to handle the UART
-//! sampling.
-//!   \param None
-//!   \return None
-//!   \sa vCOMM_Init(), TIMERA0_ISR
-///////////////////////////////////////////////////////////////////////////////
-/*
-#pragma vector=PORT2_VECTOR
-__interrupt void PORT2_ISR(void)
-{
-
-    // If we get an interrupt from the RX pin, then we have RXed a start bit
-
-	if(P_RX_IFG & RX_PIN)//P2IFG & BIT2
-	{
-      // Delay for half bit, this ensures we start sampling at the middle of each bit
-
-      TACTL &= ~(MC0 | MC1 | TAIE | TAIFG);//Halt timer, Disable interrupts
-      TACTL |= TACLR;//Clear Timer
-      //TACCTL0 &= ~CCIE;//Disable Compare interrupt
-      TACCTL0 |= CCIE;//Enable Compare interrupt
-      TACCR0 = g_unCOMM_BaudRateDelayControl; //Input delay time in compare register
-      TACTL |= MC_1;//Start timer in UP Mode (Counts to TACCR0 then starts at 0 again)
-      g_ucCOMM_Flags |= COMM_RX_SETUP;
-
-
-      __bic_SR_register_on_exit(LPM4_bits); //All Clocks and CPU etc awake now that we received a start bit.
-      //It will reset to LPM3 but in that LMP the timer can still run.
-
-
-      //while(!(TACTL & TAIFG)); //Wait until Compare register is met
-
-     //TACTL &= ~TAIFG;
-
-
-     // Enable timer interrupt, configure for baud rate
-     //TACTL &= ~(MC0 | MC1);
-     //TACTL |= TACLR;
-     //TACCTL0 |= CCIE;
-     //TACCR0 = g_unCOMM_BaudRateControl;
-
-
-     // Disable interrupt on RX
-     P_RX_IE &= ~RX_PIN;
-     //g_ucCOMM_Flags |= COMM_RX_BUSY;
-     //g_ucRXBitsLeft = 0x08;
-     //TACTL |= MC_1;
-
-     //Clear Interrupt Flag
-     P_RX_IFG &= ~RX_PIN;
-
-  }
-}*/
-
-// Original for BACKUP
-
-#pragma vector=PORT2_VECTOR
-__interrupt void PORT2_ISR(void)
-{
-
-   // Determine the source of the interrupt
-   // If we get an interrupt from the RX pin, then we have RXed a start bit
-   //case RX_PIN:
-   if(P_RX_IFG & RX_PIN)//P2IFG & BIT2
-   {
-	  if(!(RX_PIN & P_RX_IN))
-	  {
-      // Delay for half bit, this ensures we start sampling at the middle of
-      // each bit
-      TACTL &= ~(MC0 | MC1 | TAIE | TAIFG);//Halt timer, Disable interrupts
-      TACTL |= TACLR;//Clear Timer
-      TACCTL0 &= ~CCIE;//Disable Compare interrupt
-      TACCR0 = g_unCOMM_BaudRateDelayControl; //Input delay time in compare register
-      TACTL |= MC_1;//Start timer in UP Mode (Counts to TACCR0 then starts at 0 again)
-
-      while(!(TACTL & TAIFG)); //Wait until Compare register is met
-      TACTL &= ~TAIFG;
-
-      // Enable timer interrupt, configure for baud rate
-      TACTL &= ~(MC0 | MC1);
-      TACTL |= TACLR;
-      TACCTL0 |= CCIE;
-      TACCR0 = g_unCOMM_BaudRateControl;
-
-      // Disable interrupt on RX
-      P_RX_IE &= ~RX_PIN;
-      g_ucCOMM_Flags |= COMM_RX_BUSY;
-      g_ucRXBitsLeft = 0x08;
-      TACTL |= MC_1;
-	  }
-
-      //Clear Interrupt Flag
-      P_RX_IFG &= ~RX_PIN;
-
-      __bic_SR_register_on_exit(LPM4_bits); //All Clocks and CPU etc awake now that we received a start bit.
-
-   }//END if(P_RX_IFG & RX_PIN)//P2IFG & BIT2
-
-
-   if(P_RX_IFG & INT_PIN)//P2IFG & BIT0
-   {
-	   __bic_SR_register_on_exit(LPM4_bits); //All Clocks and CPU etc awake if interrupt called.
-   }//END if(P_RX_IFG & INT_PIN)
-
-}//END __interrupt void PORT2_ISR(void)
-
-//! @}
-//! @}
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
-
+///////////////////////////////////////////////////////////////////////////////
+//! \file comm.c
+//! \brief This modules implements a Timer_A driven UART on the TA0 pins
+//!
+//! This module uses the capture/compare hardware of TimerA to implement a
+//! UART on the TA0 pins. The RX pin must be the CCI0B capture input, which
+//! must also be interrupt capable. In half-duplex the TX pin must be the Out0
+//! output, in full-duplex it can be any GPIO pin.
+//!
+//! @addtogroup core
+//! @{
+//!
+//! @addtogroup comm Software UART
+//! The software UART module runs the CP link on the TimerA TA0 pins. RX bits
+//! are latched by the capture/compare unit, so interrupt latency does not
+//! move the sample points. With \ref SP_COMM_FULL_DUPLEX set, TX runs on its
+//! own schedule on TACCR1. Otherwise TX shares TACCR0 with RX and the bits
+//! are put on the line by the Out0 output unit. The module requires the use
+//! of TimerA.
+//! @{
+///////////////////////////////////////////////////////////////////////////////
+//*****************************************************************************
+// By: Kenji Yamamoto
+//     Wirless Networks Research Lab
+//     Dept of Electrical Engineering, CEFNS
+//     Northern Arizona University
+//*****************************************************************************
+
+// This module is in the BOOT link and calls itself directly, not through
+// the jump table of boot.h
+#define BOOT_RESIDENT
+
+#include <msp430x23x.h>
+#include "../core.h"
+
+#if SP_COMM_ADDRESSED && !SP_COMM_FRAMED
+#error "SP_COMM_ADDRESSED needs SP_COMM_FRAMED"
+#endif
+
+//******************  Auto-baud Configuration  ******************************//
+//! \def COMM_AUTOBAUD_BYTE
+//! \brief The first byte the CP Board sends, which is timed for the baud rate
+//!
+//! This is the sync byte of a frame or the version byte of a bare data
+//! message. Bit 7 must be clear and bit 6 set, so the last falling edge of
+//! the byte is at the start of bit 7, exactly 8 bit periods after the start
+//! bit edge.
+#if SP_COMM_FRAMED
+#define COMM_AUTOBAUD_BYTE   SP_FRAME_SYNC
+#else
+#define COMM_AUTOBAUD_BYTE   SP_DATAMESSAGE_VERSION
+#endif
+
+//! @name Message Layout
+//! Where the length is in a received message and how long that makes it.
+//! With framing it is the LEN byte of the frame, without it is the
+//! ucMsgSize field of the message. Either way it is the second byte.
+//! @{
+#if SP_COMM_FRAMED
+#define COMM_RX_LEN_OK(len)        ((len) <= COMM_FRAME_MAX_PAYLOAD)
+#define COMM_RX_LEN_TO_SIZE(len)   ((len) + SP_FRAME_OVERHEAD)
+#define COMM_MESSAGE_OFFSET        SP_FRAME_HEADER_SIZE
+#define COMM_FRAME_SEQ_INDEX       0x02
+#define COMM_FRAME_ADDRESS_INDEX   0x03
+#else
+#define COMM_RX_LEN_OK(len)        (((len) >= 0x02) && ((len) <= RX_BUFFER_SIZE))
+#define COMM_RX_LEN_TO_SIZE(len)   (len)
+#define COMM_MESSAGE_OFFSET        0x00
+#endif
+//! @}
+
+//******************  Pin Configurations  ***********************************//
+// Defines for the TX pin (currently 1.1)
+//! @name Pin Defines
+//! These defines are used so that the software has the right hardware
+//! registers for the TX and RX pins.
+//! @{
+//! \def TX_PIN
+//! \brief The pin number of the TX pin (BIT0 to BIT7)
+#define TX_PIN          BIT1
+//! \def P_TX_OUT
+//! \brief The PxOUT register that the TX pin is on
+#define P_TX_OUT        P1OUT
+//! \def P_TX_DIR
+//! \brief The PxDIR register that the TX pin is on
+#define P_TX_DIR        P1DIR
+//! \def P_TX_SEL
+//! \brief The PxSEL register that the TX pin is on
+//!
+//! Selecting the pin hands it to the TimerA Out0 output unit. This is only
+//! done in half-duplex, TA1 is not brought out on the TX pin.
+#define P_TX_SEL        P1SEL
+
+// Defines for the RX pin (currently 2.2)
+//! \def RX_PIN
+//! \brief The pin number of the RX pin (BIT0 to BIT7)
+#define RX_PIN          BIT2
+//! \def P_RX_DIR
+//! \brief The PxDIR register of the RX pin
+#define P_RX_DIR        P2DIR
+//! \def P_RX_IN
+//! \brief The PxIN register of the RX pin
+#define P_RX_IN         P2IN
+//! \def P_RX_IES
+//! \brief The PxIES register of the RX pin
+#define P_RX_IES        P2IES
+//! \def P_RX_IFG
+//! \brief The PxIFG register of the RX pin
+#define P_RX_IFG        P2IFG
+//! \def P_RX_IE
+//! \brief The PxIE register of the RX pin
+#define P_RX_IE         P2IE
+//! \def P_RX_SEL
+//! \brief The PxSEL register of the RX pin
+//!
+//! Selecting the pin routes it to the TimerA capture input. Note that this
+//! also disables the port interrupt on the pin.
+#define P_RX_SEL        P2SEL
+//! \def RX_CCIS
+//! \brief The TACCTL0 input select for the RX pin (CCI0B)
+#define RX_CCIS         CCIS_1
+
+// Define for the Interrupt pin (currently 2.0)
+//! \def INT_PIN
+//! \brief The pin number of the INT pin (BIT0 to BIT7)
+#define INT_PIN          BIT0
+//! @}
+
+//! @name TX Line Control
+//! With SP_COMM_ADDRESSED the SP Boards share the TX line, so the TX pin is
+//! only driven while a message goes out. The pull up holds the line idle.
+//! @{
+#if SP_COMM_ADDRESSED
+#define COMM_TX_DRIVE()  (P_TX_DIR |= TX_PIN)
+#define COMM_TX_RELEASE() (P_TX_DIR &= ~TX_PIN)
+#else
+#define COMM_TX_DRIVE()
+#define COMM_TX_RELEASE()
+#endif
+//! @}
+
+
+
+//******************  Control and Indication Variables  *********************//
+//! @name Control and Indication Variables
+//! These variables are used to indicate to the system the current status
+//! of the \ref comm Module and to store the baud rate timer information.
+//! @{
+//! \var volatile uint8 g_ucCOMM_Flags
+//! \brief This 8-bit field indicates the status of the COMM module.
+volatile uint8 g_ucCOMM_Flags;
+
+//! \var uint16 g_unCOMM_BaudRateControl
+//! \brief This is the value used to control the baud rate.
+//!
+//! This value is the whole number of timer ticks in one bit period for the
+//! baud rate. It is set by vCOMM_SetBitPeriod().
+uint16 g_unCOMM_BaudRateControl;
+
+//! \var uint8 g_ucCOMM_BaudRateFraction
+//! \brief The fractional part of the bit period, in 1/256 timer ticks
+//!
+//! The ISRs add this up from bit to bit and stretch a bit period by one tick
+//! each time it carries, so the bit edges do not drift from the ideal ones.
+uint8 g_ucCOMM_BaudRateFraction;
+
+//! \var uint16 g_unCOMM_BaudRateDelayControl
+//! \brief This is the value used to delay from the start bit
+//!
+//! This value is the whole number of timer ticks to wait from the beginning
+//! of the start bit to the middle of it, half of the bit period.
+uint16 g_unCOMM_BaudRateDelayControl;
+
+//! \var uint8 g_ucCOMM_BaudRateDelayFraction
+//! \brief The fractional part of the start delay, in 1/256 timer ticks
+uint8 g_ucCOMM_BaudRateDelayFraction;
+
+//! \var uint16 g_unCOMM_BytePeriod
+//! \brief The number of timer ticks in 10 bit periods, modulo 0x10000
+//!
+//! This is the time from one start bit edge to the next when the CP Board
+//! sends bytes back to back at our rate.
+uint16 g_unCOMM_BytePeriod;
+
+//! \var uint16 g_unCOMM_WakeLatency
+//! \brief The TimerA ticks from a port interrupt to the TAR read in
+//! PORT2_ISR(), measured at start up by vCOMM_MeasureWakeLatency()
+uint16 g_unCOMM_WakeLatency;
+
+//! \var uint16 g_unCOMM_PortStartDelay
+//! \brief The start delay PORT2_ISR() uses when the MCU was awake
+//!
+//! The start delay less the measured interrupt latency. Set by
+//! vCOMM_SetPortStartDelays().
+uint16 g_unCOMM_PortStartDelay;
+
+//! \var uint16 g_unCOMM_PortWakeStartDelay
+//! \brief The start delay PORT2_ISR() uses when the start bit woke the MCU
+//! from LPM3 or LPM4
+//!
+//! As \ref g_unCOMM_PortStartDelay, less the DCO start time as well.
+uint16 g_unCOMM_PortWakeStartDelay;
+
+//! \var uint8 g_ucTimeoutOverflowsLeft
+//! \brief The number of TimerA overflows left in a timed wait for a message.
+uint8 g_ucTimeoutOverflowsLeft;
+
+#if SP_COMM_FRAMED
+//! \var uint8 g_ucCOMM_TXSequence
+//! \brief The SEQ sent in every frame, the one of the request being answered
+uint8 g_ucCOMM_TXSequence;
+
+//! \var uint16 g_unCOMM_ByteTimeControl
+//! \brief The number of timer ticks in one byte time (10 bit periods)
+//!
+//! This is the unit of the inter-byte timeout on CCR2.
+uint16 g_unCOMM_ByteTimeControl;
+#endif
+//! @}
+
+//******************  RX Variables  *****************************************//
+//! @name Receive Variables
+//! These variables are used in the receiving of data on the \ref comm Module.
+//! @{
+//! \var uint8 g_ucaRXMessages[COMM_RX_MESSAGES][RX_BUFFER_SIZE]
+//! \brief The software UART RX message buffers
+//!
+//! The TimerA ISR puts each byte straight into the buffer it is filling.
+//! When a message is complete it moves on to the other buffer, so the next
+//! request can come in while the core still works on this one.
+uint8 g_ucaRXMessages[COMM_RX_MESSAGES][RX_BUFFER_SIZE];
+
+//! \var volatile uint8 g_ucRXFill
+//! \brief The message buffer the ISR is filling.
+volatile uint8 g_ucRXFill;
+
+//! \var volatile uint8 g_ucRXMessageIndex
+//! \brief The number of bytes in the message buffer the ISR is filling.
+volatile uint8 g_ucRXMessageIndex;
+
+//! \var uint8 g_ucRXTake
+//! \brief The message buffer with the oldest complete message.
+uint8 g_ucRXTake;
+
+//! \var volatile uint8 g_ucRXMessageCount
+//! \brief The number of complete messages not released by the core yet.
+volatile uint8 g_ucRXMessageCount;
+
+//! \var uint8 g_ucRXShift
+//! \brief The shift register the bits of the byte being received go into.
+uint8 g_ucRXShift;
+
+//! \var uint8 g_ucRXBitsLeft
+//! \brief The number of bits left to be received for the current byte.
+uint8 g_ucRXBitsLeft;
+
+//! \var uint16 g_unRXBitFraction
+//! \brief The RX bit timing fraction accumulator
+//!
+//! The low byte holds the 1/256 timer ticks the RX sample point is behind
+//! the ideal one, the high byte the carry into the next bit period.
+uint16 g_unRXBitFraction;
+
+//! \var uint16 g_unRXLastStart
+//! \brief The capture time of the last start bit edge.
+uint16 g_unRXLastStart;
+
+//! \var uint8 g_ucRXLastStartValid
+//! \brief TRUE if the next start bit may follow the one at g_unRXLastStart
+//! back to back.
+uint8 g_ucRXLastStartValid;
+
+#if SP_COMM_AUTOBAUD
+//! \var uint8 g_ucAutoBaudEdges
+//! \brief The number of falling edges in the auto-baud byte, start bit
+//! included.
+uint8 g_ucAutoBaudEdges;
+
+//! \var uint8 g_ucAutoBaudEdgesLeft
+//! \brief The number of falling edges of the auto-baud byte still to come.
+uint8 g_ucAutoBaudEdgesLeft;
+
+//! \var uint16 g_unAutoBaudStart
+//! \brief The timer count at the start bit edge of the auto-baud byte.
+uint16 g_unAutoBaudStart;
+#endif
+
+#if SP_COMM_FRAMED
+//! \var uint8 g_ucRXTimeoutLeft
+//! \brief The number of byte times left before a partial frame is dropped.
+uint8 g_ucRXTimeoutLeft;
+#endif
+//! @}
+
+//******************  Link Statistics  **************************************//
+//! @name Link Statistics
+//! These counters are reported to the CP Board in a REPORT_LINK_STATUS, so
+//! a noisy link shows up as numbers instead of as lost messages.
+//! @{
+//! \var volatile uint16 g_unCOMM_RXOverruns
+//! \brief The number of bytes lost because both message buffers were full.
+volatile uint16 g_unCOMM_RXOverruns;
+
+//! \var volatile uint16 g_unCOMM_RXFramingErrors
+//! \brief The number of frames dropped for a bad length, a bad CRC or an
+//! inter-byte timeout.
+volatile uint16 g_unCOMM_RXFramingErrors;
+
+//! \var volatile uint16 g_unCOMM_RXStopBitErrors
+//! \brief The number of bytes dropped because the stop bit was low.
+volatile uint16 g_unCOMM_RXStopBitErrors;
+
+//! \var volatile uint16 g_unCOMM_RXBytes
+//! \brief The number of bytes received with a good stop bit.
+volatile uint16 g_unCOMM_RXBytes;
+
+//! \var uint16 g_unCOMM_TXBytes
+//! \brief The number of bytes queued to be sent.
+uint16 g_unCOMM_TXBytes;
+
+#if SP_COMM_FRAMED
+//! \var uint16 g_unCOMM_RXCRCErrors
+//! \brief The number of frames dropped for a bad CRC, these are counted in
+//! g_unCOMM_RXFramingErrors as well.
+uint16 g_unCOMM_RXCRCErrors;
+#endif
+
+//! \var volatile int16 g_iCOMM_RXByteDrift
+//! \brief How many timer ticks longer 10 bit periods of the CP Board are
+//! than \ref g_unCOMM_BytePeriod, from the last two back to back bytes.
+volatile int16 g_iCOMM_RXByteDrift;
+
+#if SP_COMM_LATENCY_STATS
+//! \var volatile uint16 g_unCOMM_ISRLatencyMax
+//! \brief The most timer ticks from a bit compare or a start bit capture
+//! to its ISR.
+volatile uint16 g_unCOMM_ISRLatencyMax;
+#endif
+//! @}
+
+//******************  TX Variables  *****************************************//
+//! @name Transmit Variables
+//! There variables are used in the transmitting of data on the \ref comm
+//! Module.
+//! @{
+//! \var volatile uint8 g_ucaTXBuffer[TX_BUFFER_SIZE]
+//! \brief The software UART TX ring buffer
+//!
+//! Bytes are queued here by \e vCOMM_SendByte() and taken off by the TimerA
+//! ISR, which starts the next byte as the stop bit of the previous one ends.
+volatile uint8 g_ucaTXBuffer[TX_BUFFER_SIZE];
+
+//! \var volatile uint8 g_ucTXBufferHead
+//! \brief The index into g_ucaTXBuffer showing the current write position.
+volatile uint8 g_ucTXBufferHead;
+
+//! \var volatile uint8 g_ucTXBufferTail
+//! \brief The index into g_ucaTXBuffer showing the current read position.
+volatile uint8 g_ucTXBufferTail;
+
+//! \var uint16 g_unTXBuffer
+//! \brief The bits of the current byte still to be put on the line.
+//!
+//! In half-duplex the byte is shifted out LSB first, followed by the stop
+//! bit and one more mark bit. The compare that would output the last mark
+//! bit marks the end of the stop bit. In full-duplex the start bit is in
+//! bit 0, followed by the byte and the stop bit.
+uint16 g_unTXBuffer;
+
+//! \var uint8 g_ucTXBitsLeft
+//! \brief The number of bits left to be transmitted for the current byte.
+uint8 g_ucTXBitsLeft;
+
+//! \var uint16 g_unTXBitFraction
+//! \brief The TX bit timing fraction accumulator
+//!
+//! Used the same way as \e g_unRXBitFraction, for the TX bit edges.
+uint16 g_unTXBitFraction;
+
+//! \var uint8 g_ucaTXLastMessage[COMM_FRAME_MAX_PAYLOAD]
+//! \brief A copy of the last message sent, for answering a NAK_PKT.
+uint8 g_ucaTXLastMessage[COMM_FRAME_MAX_PAYLOAD];
+
+//! \var uint8 g_ucTXLastMessageSize
+//! \brief The size of the message in g_ucaTXLastMessage, 0 if none.
+uint8 g_ucTXLastMessageSize;
+
+#if SP_COMM_FRAMED
+//! \var uint8 g_ucTXLastSequence
+//! \brief The SEQ g_ucaTXLastMessage was sent with, the request it answers
+uint8 g_ucTXLastSequence;
+#endif
+//! @}
+
+
+
+//******************  Functions  ********************************************//
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Gets the receiver ready for the next start bit
+//!
+//! TimerA runs from the SMCLK, which is stopped in LPM3. So the first start
+//! bit of a message is caught by the port interrupt, which can wake the MCU
+//! from any LPM. Once a message is in progress, or a message is waiting to
+//! be taken, the MCU stays in LPM0 and the start bits are timestamped
+//! by the CCR0 capture unit instead.
+//!
+//! In half-duplex CCR0 is shared with the transmitter, so nothing is done
+//! while a byte is being sent. The transmitter calls this function again
+//! when it is done.
+//!   \param None
+//!   \return None
+//!   \sa PORT2_ISR(), TIMERA0_ISR()
+///////////////////////////////////////////////////////////////////////////////
+void vCOMM_ArmReceiver(void)
+{
+#if !SP_COMM_FULL_DUPLEX
+  if (g_ucCOMM_Flags & COMM_TX_BUSY)
+    return;
+#endif
+
+  // The auto-baud edges have to be timed by the capture unit
+  if ((g_ucRXMessageIndex == 0x00) && (g_ucRXMessageCount == 0x00) &&
+      !(g_ucCOMM_Flags & COMM_AUTOBAUD))
+  {
+    // Wait for the start of a message on the port interrupt
+    g_ucRXLastStartValid = FALSE;
+    TACCTL0 = OUT;
+    P_RX_SEL &= ~RX_PIN;
+    P_RX_IFG &= ~RX_PIN;
+    P_RX_IE  |= RX_PIN;
+  }
+  else
+  {
+    // Capture the falling edge of the next start bit. Out0 is kept high.
+    P_RX_IE  &= ~RX_PIN;
+    P_RX_SEL |= RX_PIN;
+    TACCTL0 = CM_2 | RX_CCIS | SCS | CAP | CCIE | OUT;
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Works out the start delays for a start bit caught by PORT2_ISR()
+//!
+//! The half bit delay is counted from the TAR read in the ISR, which comes
+//! some time after the falling edge. That time is taken off, but the delay
+//! is never made shorter than \ref COMM_MIN_START_TICKS.
+//!   \param None
+//!   \return None
+//!   \sa vCOMM_MeasureWakeLatency()
+///////////////////////////////////////////////////////////////////////////////
+void vCOMM_SetPortStartDelays(void)
+{
+  uint16 unDelay;
+
+  unDelay = g_unCOMM_BaudRateDelayControl;
+
+  if (unDelay > g_unCOMM_WakeLatency + COMM_MIN_START_TICKS)
+    g_unCOMM_PortStartDelay = unDelay - g_unCOMM_WakeLatency;
+  else
+    g_unCOMM_PortStartDelay = COMM_MIN_START_TICKS;
+
+  if (unDelay > g_unCOMM_WakeLatency + COMM_DCO_WAKE_TICKS + COMM_MIN_START_TICKS)
+    g_unCOMM_PortWakeStartDelay = unDelay - g_unCOMM_WakeLatency - COMM_DCO_WAKE_TICKS;
+  else
+    g_unCOMM_PortWakeStartDelay = COMM_MIN_START_TICKS;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Measures the latency of the port interrupt that catches the first
+//! start bit of a message
+//!
+//! The RX pin interrupt flag is set by software with GIE off, and the MCU
+//! is put in LPM3, so the interrupt is taken right away on the same path a
+//! start bit takes. TimerA stops with the SMCLK, so the ticks from here to
+//! the TAR read in PORT2_ISR() are the entry and prologue time only. The
+//! DCO start time is added as \ref COMM_DCO_WAKE_TICKS instead.
+//!
+//! TimerA must be running and the RX pin interrupt must not be in use.
+//! Returns with GIE off, as vCOMM_Init() runs before interrupts are enabled.
+//!   \param None
+//!   \return None
+//!   \sa PORT2_ISR(), vCOMM_SetPortStartDelays()
+///////////////////////////////////////////////////////////////////////////////
+void vCOMM_MeasureWakeLatency(void)
+{
+  __bic_SR_register(GIE);
+
+  g_ucCOMM_Flags |= COMM_WAKE_CAL;
+  P_RX_IE |= RX_PIN;
+  P_RX_IFG |= RX_PIN;
+
+  // PORT2_ISR() takes this away from its own TAR read
+  g_unCOMM_WakeLatency = TAR;
+  __bis_SR_register(GIE + LPM3_bits);
+
+  __bic_SR_register(GIE);
+  P_RX_IE &= ~RX_PIN;
+  vCOMM_SetPortStartDelays();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Works out the bit period for a baud rate
+//!   \param unBaud The baud rate, in units of 100 bit/s
+//!   \return The bit period in 1/256 timer ticks
+///////////////////////////////////////////////////////////////////////////////
+uint32 ulCOMM_BitPeriod(uint16 unBaud)
+{
+  return (((CORE_SMCLK_HZ / 100) << 8) + (unBaud >> 1)) / unBaud;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Sets the bit period of the software UART
+//!
+//! The start delay is half of the bit period. The caller must make sure the
+//! ISRs do not use the timing values while they change.
+//!   \param ulPeriod The bit period in 1/256 timer ticks
+//!   \return None
+//!   \sa ulCOMM_BitPeriod()
+///////////////////////////////////////////////////////////////////////////////
+void vCOMM_SetBitPeriod(uint32 ulPeriod)
+{
+  g_unCOMM_BaudRateControl = (uint16)(ulPeriod >> 8);
+  g_ucCOMM_BaudRateFraction = (uint8)ulPeriod;
+  g_unCOMM_BaudRateDelayControl = (uint16)(ulPeriod >> 9);
+  g_ucCOMM_BaudRateDelayFraction = (uint8)(ulPeriod >> 1);
+  g_unCOMM_BytePeriod = (uint16)((ulPeriod * 10) >> 8);
+  vCOMM_SetPortStartDelays();
+#if SP_COMM_FRAMED
+  // A byte time does not fit the timer at slow rates with a 16 MHz SMCLK,
+  // the timeout is then a little shorter
+  ulPeriod = (ulPeriod * 10) >> 8;
+  if (ulPeriod > 0xFFFF)
+    ulPeriod = 0xFFFF;
+  g_unCOMM_ByteTimeControl = (uint16)ulPeriod;
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief This sets up the hardware resources for doing software UART
+//!
+//! Since we are doing UART without the USCI, we use TimerA and its
+//! capture/compare unit 0 to control the baud rate. TimerA free-runs in
+//! continuous mode and every bit edge is scheduled against TAR, so the bits
+//! do not drift with the interrupt latency. The software UART expects 1
+//! start bit, 8 data bits and 1 stop bit.
+//!
+//! To ensure correct operation of the software UART, the \ref comm_pins
+//! "Comm Pin Defines" must be set correctly.
+//!   \param ucBaud The baud rate define to use, 9600 baud if it is not one
+//!   \return None
+//!   \sa vCOMM_SendByte(), TIMERA0_ISR()
+///////////////////////////////////////////////////////////////////////////////
+void vCOMM_Init(uint16 ucBaud)
+{
+  // BUG FIX: Clear TACTL in case someone was using it before us
+  TACTL = 0x0000;
+
+  // Idle state for UART is high, so take the TX high. In half-duplex Out0
+  // drives the pin in OUTMOD_0, where the OUT bit sets the level.
+  TACCTL0 = OUT;
+  TACCTL1 = 0x0000;
+  TACCTL2 = 0x0000;
+  P_TX_OUT |= TX_PIN;
+
+  // We set the directionality of the TX and RX pins based on the defines
+  P_TX_DIR |= TX_PIN;
+#if !SP_COMM_FULL_DUPLEX
+  P_TX_SEL |= TX_PIN;
+#endif
+  P_RX_DIR &= ~RX_PIN;
+
+  // On a shared line the pull up holds TX high until we have something to say
+  COMM_TX_RELEASE();
+
+  // Empty the RX message buffers
+  g_ucRXFill = 0x00;
+  g_ucRXTake = 0x00;
+  g_ucRXMessageIndex = 0x00;
+  g_ucRXMessageCount = 0x00;
+
+  vCOMM_ClearLinkStatus();
+  g_iCOMM_RXByteDrift = 0x0000;
+  g_ucRXLastStartValid = FALSE;
+
+  // Empty the TX ring buffer
+  g_ucTXBufferHead = 0x00;
+  g_ucTXBufferTail = 0x00;
+
+  // The falling edge on RX is the start bit
+  P_RX_IES |= RX_PIN;
+
+  // The timer interrupt controls the baud rate, worked out for the SMCLK
+  if (unCOMM_BaudForRate(ucBaud) == 0x0000)
+    ucBaud = BAUD_9600;
+  vCOMM_SetBitPeriod(ulCOMM_BitPeriod(ucBaud));
+
+  g_ucTXLastMessageSize = 0x00;
+#if SP_COMM_FRAMED
+  g_ucCOMM_TXSequence = SP_FRAME_SEQ_NONE;
+  g_ucTXLastSequence = SP_FRAME_SEQ_NONE;
+#endif
+
+  // Use the SMCLK and let TimerA free-run in continuous mode
+  TACTL = TASSEL_2 | MC_2 | TACLR;
+
+  g_ucCOMM_Flags = COMM_RUNNING;
+
+  // Time the port interrupt so the first start bit of a message is sampled
+  // in the middle
+  g_unCOMM_WakeLatency = 0x0000;
+  vCOMM_MeasureWakeLatency();
+#if SP_COMM_AUTOBAUD
+  vCOMM_StartAutoBaud();
+#else
+  vCOMM_ArmReceiver();
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Changes the baud rate of the software UART
+//!
+//! Only call this with the link idle, anything being sent or received is
+//! lost.
+//!   \param unBaud The baud rate, in units of 100 bit/s
+//!   \return None
+//!   \sa unCOMM_BaudForRate(), unCOMM_GetBaud()
+///////////////////////////////////////////////////////////////////////////////
+void vCOMM_SetBaud(uint16 unBaud)
+{
+  uint32 ulPeriod;
+
+  ulPeriod = ulCOMM_BitPeriod(unBaud);
+
+  __bic_SR_register(GIE);
+  vCOMM_SetBitPeriod(ulPeriod);
+  __bis_SR_register(GIE);
+
+  vCOMM_FlushRX();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Gets the current baud rate of the software UART
+//!
+//! After autobaud this is the measured rate, rounded to 100 bit/s.
+//!   \param None
+//!   \return The baud rate, in units of 100 bit/s
+//!   \sa vCOMM_SetBaud()
+///////////////////////////////////////////////////////////////////////////////
+uint16 unCOMM_GetBaud(void)
+{
+  uint32 ulPeriod;
+
+  ulPeriod = ((uint32)g_unCOMM_BaudRateControl << 8) | g_ucCOMM_BaudRateFraction;
+
+  return (uint16)((((CORE_SMCLK_HZ / 100) << 8) + (ulPeriod >> 1)) / ulPeriod);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Checks a baud rate against the supported ones
+//!
+//! This is used for rates coming from the CP Board in a BAUD_CHANGE.
+//!   \param unRate The baud rate in units of 100 bit/s
+//!   \return The baud rate define, or 0 if the rate is not supported
+//!   \sa vCOMM_SetBaud()
+///////////////////////////////////////////////////////////////////////////////
+uint16 unCOMM_BaudForRate(uint16 unRate)
+{
+  switch(unRate)
+  {
+    case BAUD_1200:
+    case BAUD_9600:
+    case BAUD_19200:
+    case BAUD_57600:
+    case BAUD_115200:
+    case BAUD_230400:
+    case BAUD_345600:
+    case BAUD_460800:
+      return unRate;
+
+    default:
+      return 0x0000;
+  }
+}
+
+#if SP_COMM_AUTOBAUD
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Measures the baud rate on the next byte from the CP Board
+//!
+//! The falling edges of the next byte, which must be \ref COMM_AUTOBAUD_BYTE,
+//! are timestamped by the capture unit. The last one is 8 bit periods after
+//! the start bit edge, which gives the bit period to 1/8 of a timer tick
+//! with a shift. The byte is then finished at the measured rate. The bit
+//! period must fit 8 times in the 16 bit timer.
+//!
+//! The capture unit does not run in LPM3, so the MCU must wait for the byte
+//! in LPM0, as \e ucCOMM_WaitForMessage() does. The rate stays unconfirmed
+//! until a good frame comes in. A bad frame before that starts the
+//! measurement again.
+//!   \param None
+//!   \return None
+//!   \sa TIMERA0_ISR(), ucCOMM_WaitForMessage()
+///////////////////////////////////////////////////////////////////////////////
+void vCOMM_StartAutoBaud(void)
+{
+  uint8 ucBit;
+  uint8 ucLevel;
+
+  // Count the falling edges of the byte, the start bit is the first
+  g_ucAutoBaudEdges = 0x01;
+  ucLevel = 0x00;
+  for (ucBit = 0x01; ucBit != 0x00; ucBit <<= 1)
+  {
+    if (COMM_AUTOBAUD_BYTE & ucBit)
+      ucLevel = 0x01;
+    else if (ucLevel)
+    {
+      g_ucAutoBaudEdges++;
+      ucLevel = 0x00;
+    }
+  }
+
+  __bic_SR_register(GIE);
+
+  g_ucAutoBaudEdgesLeft = g_ucAutoBaudEdges;
+  g_ucRXLastStartValid = FALSE;
+  g_ucCOMM_Flags |= COMM_AUTOBAUD | COMM_BAUD_UNCONFIRMED;
+  g_ucCOMM_Flags &= ~COMM_RX_BUSY;
+  g_ucRXTake = g_ucRXFill;
+  g_ucRXMessageIndex = 0x00;
+  g_ucRXMessageCount = 0x00;
+  vCOMM_ArmReceiver();
+
+  __bis_SR_register(GIE);
+}
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Takes the next byte off the TX ring buffer
+//!
+//! Loads the next queued byte into the shift register. In half-duplex Out0
+//! is set up to put its start bit on the line at the next CCR0 compare, in
+//! full-duplex the TimerA1 ISR puts it on the line at the next CCR1
+//! compare. The caller must have set the compare register to the time of
+//! the start bit edge.
+//!   \param None
+//!   \return None
+//!   \sa vCOMM_SendByte(), TIMERA0_ISR(), TIMERA1_ISR()
+///////////////////////////////////////////////////////////////////////////////
+void vCOMM_LoadNextTXByte(void)
+{
+#if SP_COMM_FULL_DUPLEX
+  // Push the value to the shift register, framed by the start and stop bits
+  g_unTXBuffer = ((uint16)g_ucaTXBuffer[g_ucTXBufferTail] << 1) | 0x0200;
+  g_ucTXBufferTail = (g_ucTXBufferTail + 1) & TX_BUFFER_MASK;
+
+  // Reset the bit count so the ISR knows how many bits left to send
+  g_ucTXBitsLeft = 0x0A;
+#else
+  // Push the value to the shift register, followed by the stop bit and the
+  // end of frame mark
+  g_unTXBuffer = (uint16)g_ucaTXBuffer[g_ucTXBufferTail] | 0x0300;
+  g_ucTXBufferTail = (g_ucTXBufferTail + 1) & TX_BUFFER_MASK;
+
+  // Reset the bit count so the ISR knows how many bits left to send
+  g_ucTXBitsLeft = 0x0A;
+
+  // Out0 resets at the compare, that is the start bit
+  TACCTL0 = OUTMOD_5 | CCIE;
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Sends a byte via the software UART
+//!
+//! This function pushes \e ucChar into the TX ring buffer, where the TimerA
+//! ISR can access it, and returns. If the transmitter is idle, the first
+//! start bit is scheduled one bit period from now. After that the ISR takes
+//! each byte off the buffer as the stop bit of the previous one ends, so a
+//! whole message goes out back to back from a single start.
+//!
+//! In full-duplex the bits are timed by CCR1 and TIMERA1_ISR() writes the
+//! pin as its first instruction. In half-duplex the ISR programs the Out0
+//! output mode for each bit ahead of time and the output unit changes the
+//! pin on the compare, so the bit edges are exact, but the transmitter takes
+//! CCR0 from the receiver until the ring buffer is empty.
+//!
+//! The call only blocks, in LPM0, while the ring buffer is full.
+//!   \param ucChar The 8-bit value to send
+//!   \return None
+//!   \sa TIMERA0_ISR(), TIMERA1_ISR(), vCOMM_WaitForTXComplete()
+///////////////////////////////////////////////////////////////////////////////
+void vCOMM_SendByte(uint8 ucChar)
+{
+  uint8 ucNextHead;
+
+  ucNextHead = (g_ucTXBufferHead + 1) & TX_BUFFER_MASK;
+
+  // If the buffer is full, wait for the ISR to take a byte off it
+  while (ucNextHead == g_ucTXBufferTail)
+    __bis_SR_register(GIE + LPM0_bits);
+
+  // The ISR must not see the transmitter idle with a byte queued
+  __bic_SR_register(GIE);
+
+  g_ucaTXBuffer[g_ucTXBufferHead] = ucChar;
+  g_ucTXBufferHead = ucNextHead;
+  g_unCOMM_TXBytes++;
+
+  if (!(g_ucCOMM_Flags & COMM_TX_BUSY))
+  {
+    // Indicate in the status register that we are now busy
+    g_ucCOMM_Flags |= COMM_TX_BUSY;
+    COMM_TX_DRIVE();
+
+#if SP_COMM_FULL_DUPLEX
+    // The start bit goes out one bit period from now
+    g_unTXBitFraction = 0x0000;
+    TACCR1 = TAR + g_unCOMM_BaudRateControl;
+    vCOMM_LoadNextTXByte();
+    TACCTL1 = CCIE;
+#else
+    // The receiver can not use CCR0 while we are sending
+    P_RX_IE &= ~RX_PIN;
+
+    // The start bit goes out one bit period from now
+    g_unTXBitFraction = 0x0000;
+    TACCR0 = TAR + g_unCOMM_BaudRateControl;
+    vCOMM_LoadNextTXByte();
+#endif
+  }
+
+  __bis_SR_register(GIE);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Waits until the TX ring buffer has been put on the line
+//!
+//! TimerA runs from the SMCLK, so this must be called before anything puts
+//! the MCU in LPM3 or deeper, or the rest of the message will be stuck until
+//! the next wake up. The system waits in LPM0.
+//!   \param None
+//!   \return None
+//!   \sa vCOMM_SendByte()
+///////////////////////////////////////////////////////////////////////////////
+void vCOMM_WaitForTXComplete(void)
+{
+  while (g_ucCOMM_Flags & COMM_TX_BUSY)
+    __bis_SR_register(GIE + LPM0_bits);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Shuts off the software modules
+//!
+//! This shuts down TimerA and disables all of the interrupts used
+//!   \param None
+//!   \return None
+//!   \sa vCOMM_Init()
+///////////////////////////////////////////////////////////////////////////////
+void vCOMM_Shutdown(void)
+{
+  // Halt timer and clear interrupt enables
+  TACTL &= ~(MC0 | MC1 | TAIE | TAIFG);
+  TACCTL0 = 0x0000;
+  TACCTL1 = 0x0000;
+  TACCTL2 = 0x0000;
+
+  // Drop anything still queued for TX
+  g_ucTXBufferHead = g_ucTXBufferTail;
+  g_ucCOMM_Flags &= ~COMM_TX_BUSY;
+
+  // Disable RX interrupt and give the pins back to the ports
+  P_RX_IE &= ~RX_PIN;
+  P_RX_SEL &= ~RX_PIN;
+  P_TX_SEL &= ~TX_PIN;
+  g_ucCOMM_Flags &= ~COMM_RUNNING;
+
+  //Let TX drop
+  P_TX_OUT &= ~TX_PIN;
+  COMM_TX_RELEASE();
+}
+
+#if SP_COMM_FRAMED
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Adds a byte to a running CRC-16 CCITT
+//!
+//! Computes the CRC-16 CCITT (polynomial 0x1021) a byte at a time with
+//! shifts and XORs, without a lookup table. Start with 0xFFFF.
+//!   \param unCRC The CRC so far
+//!   \param ucData The next byte
+//!   \return The updated CRC
+//!   \sa msg_frame
+///////////////////////////////////////////////////////////////////////////////
+uint16 unCOMM_CRC16Update(uint16 unCRC, uint8 ucData)
+{
+  unCRC = (unCRC >> 8) | (unCRC << 8);
+  unCRC ^= ucData;
+  unCRC ^= (unCRC & 0x00FF) >> 4;
+  unCRC ^= unCRC << 12;
+  unCRC ^= (unCRC & 0x00FF) << 5;
+
+  return unCRC;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Sends a message in a frame
+//!
+//! Queues the sync byte, the length, the sequence number, the address, the
+//! message and the CRC. The CRC is worked out while the bytes are queued.
+//! Nothing is sent in reply to a broadcast request.
+//!   \param p_ucMessage Pointer to the message bytes
+//!   \param ucSize The number of message bytes
+//!   \return None
+//!   \sa msg_frame
+///////////////////////////////////////////////////////////////////////////////
+void vCOMM_SendFrame(uint8 * p_ucMessage, uint8 ucSize)
+{
+  uint8 ucLoopCount;
+  uint16 unCRC;
+
+#if SP_COMM_ADDRESSED
+  if (g_ucCOMM_Flags & COMM_BROADCAST)
+    return;
+#endif
+
+  vCOMM_SendByte(SP_FRAME_SYNC);
+  vCOMM_SendByte(ucSize);
+  unCRC = unCOMM_CRC16Update(0xFFFF, ucSize);
+  vCOMM_SendByte(g_ucCOMM_TXSequence);
+  unCRC = unCOMM_CRC16Update(unCRC, g_ucCOMM_TXSequence);
+#if SP_COMM_ADDRESSED
+  vCOMM_SendByte((uint8)(COMM_ADDRESS >> 8));
+  unCRC = unCOMM_CRC16Update(unCRC, (uint8)(COMM_ADDRESS >> 8));
+  vCOMM_SendByte((uint8)COMM_ADDRESS);
+  unCRC = unCOMM_CRC16Update(unCRC, (uint8)COMM_ADDRESS);
+#endif
+
+  for (ucLoopCount = 0x00; ucLoopCount < ucSize; ucLoopCount++)
+  {
+    vCOMM_SendByte(p_ucMessage[ucLoopCount]);
+    unCRC = unCOMM_CRC16Update(unCRC, p_ucMessage[ucLoopCount]);
+  }
+
+  vCOMM_SendByte((uint8)(unCRC >> 8));
+  vCOMM_SendByte((uint8)unCRC);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Asks the CP Board to send its last message again
+//!
+//! The NAK is not kept as the last message, so a NAK from the CP Board
+//! still gets the last real reply.
+//!   \param None
+//!   \return None
+//!   \sa NAK_PKT
+///////////////////////////////////////////////////////////////////////////////
+void vCOMM_SendNAK(void)
+{
+  union SP_32BitDataMessage NAKMsg;
+
+  NAKMsg.fields.ucMsgVersion = SP_DATAMESSAGE_VERSION;
+  NAKMsg.fields.ucMsgSize = SP_32BITDATAMESSAGE_SIZE;
+  NAKMsg.fields.ucMsgType = NAK_PKT;
+  NAKMsg.fields.ucSensorNumber = 0x00;
+  NAKMsg.fields.ucData1_HI_BYTE = 0x00;
+  NAKMsg.fields.ucData1_LO_BYTE = 0x00;
+  NAKMsg.fields.ucData2_HI_BYTE = 0x00;
+  NAKMsg.fields.ucData2_LO_BYTE = 0x00;
+
+  // The SEQ of the corrupt frame is not known
+  g_ucCOMM_TXSequence = SP_FRAME_SEQ_NONE;
+  vCOMM_SendFrame(NAKMsg.ucByteStream, SP_32BITDATAMESSAGE_SIZE);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Checks a received frame
+//!
+//! The RX ISR has already found the sync byte and collected LEN bytes plus
+//! the CRC. This checks that the message is at least as long as the one we
+//! are waiting for and that the CRC is good.
+//!   \param p_ucFrame Pointer to the frame, starting at the sync byte
+//!   \param ucSize The smallest message size accepted
+//!   \return COMM_OK or COMM_FRAME_ERROR
+//!   \sa ucCOMM_WaitForMessage()
+///////////////////////////////////////////////////////////////////////////////
+uint8 ucCOMM_CheckFrame(uint8 * p_ucFrame, uint8 ucSize)
+{
+  uint8 ucLoopCount;
+  uint16 unCRC;
+
+  if (p_ucFrame[1] < ucSize)
+    return COMM_FRAME_ERROR;
+  ucSize = p_ucFrame[1];
+
+  unCRC = 0xFFFF;
+  for (ucLoopCount = 0x01; ucLoopCount < ucSize + SP_FRAME_HEADER_SIZE; ucLoopCount++)
+    unCRC = unCOMM_CRC16Update(unCRC, p_ucFrame[ucLoopCount]);
+
+  if ((p_ucFrame[ucSize + SP_FRAME_HEADER_SIZE] != (uint8)(unCRC >> 8)) ||
+      (p_ucFrame[ucSize + SP_FRAME_HEADER_SIZE + 1] != (uint8)unCRC))
+  {
+    g_unCOMM_RXCRCErrors++;
+    return COMM_FRAME_ERROR;
+  }
+
+  return COMM_OK;
+}
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Puts a received byte in the message buffer being filled
+//!
+//! Called by the RX ISR for each byte with a good stop bit. With framing,
+//! bytes are dropped until the sync byte, which also gets rid of
+//! SP_WAKE_BYTE. Without framing, SP_WAKE_BYTE is dropped when it shows up
+//! in front of a message. A message with a length that does
+//! not fit the buffer is dropped. Once the whole message is in, the ISR
+//! moves on to the other buffer. If the core has not released that one yet
+//! the bytes are lost until it does.
+//!   \param ucByte The received byte
+//!   \return None
+//!   \sa TIMERA0_ISR()
+///////////////////////////////////////////////////////////////////////////////
+void vCOMM_PutRXByte(uint8 ucByte)
+{
+  uint8 * p_ucMessage;
+
+  g_unCOMM_RXBytes++;
+
+  if (g_ucRXMessageCount == COMM_RX_MESSAGES)
+  {
+    g_unCOMM_RXOverruns++;
+    return;
+  }
+
+#if SP_COMM_FRAMED
+  if ((g_ucRXMessageIndex == 0x00) && (ucByte != SP_FRAME_SYNC))
+    return;
+#else
+  if ((g_ucRXMessageIndex == 0x00) && (ucByte == SP_WAKE_BYTE))
+    return;
+#endif
+
+  if ((g_ucRXMessageIndex == 0x01) && !COMM_RX_LEN_OK(ucByte))
+  {
+    g_unCOMM_RXFramingErrors++;
+    g_ucRXMessageIndex = 0x00;
+    return;
+  }
+
+  p_ucMessage = g_ucaRXMessages[g_ucRXFill];
+  p_ucMessage[g_ucRXMessageIndex++] = ucByte;
+
+  if ((g_ucRXMessageIndex > 0x01) &&
+      (g_ucRXMessageIndex == COMM_RX_LEN_TO_SIZE(p_ucMessage[1])))
+  {
+    g_ucRXMessageIndex = 0x00;
+    g_ucRXFill ^= 0x01;
+    g_ucRXMessageCount++;
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Hands the oldest message buffer back to the RX ISR
+//!
+//! The core calls this once it is done with a message it took, which
+//! includes sending a reply built in the same buffer.
+//!   \param None
+//!   \return None
+//!   \sa p_COMM_Take32BitDataMessage()
+///////////////////////////////////////////////////////////////////////////////
+void vCOMM_ReleaseMessage(void)
+{
+  __bic_SR_register(GIE);
+
+  if (g_ucRXMessageCount)
+  {
+    g_ucRXTake ^= 0x01;
+    g_ucRXMessageCount--;
+  }
+
+  // A byte on its way in re-arms the receiver when it is done
+  if (!(g_ucCOMM_Flags & COMM_RX_BUSY))
+    vCOMM_ArmReceiver();
+
+  __bis_SR_register(GIE);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Empties the RX message buffers
+//!   \param None
+//!   \return None
+///////////////////////////////////////////////////////////////////////////////
+void vCOMM_FlushRX(void)
+{
+  __bic_SR_register(GIE);
+
+  g_ucRXTake = g_ucRXFill;
+  g_ucRXMessageIndex = 0x00;
+  g_ucRXMessageCount = 0x00;
+#if SP_COMM_FRAMED
+  TACCTL2 = 0x0000;
+#endif
+  if (!(g_ucCOMM_Flags & COMM_RX_BUSY))
+    vCOMM_ArmReceiver();
+
+  __bis_SR_register(GIE);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Checks whether anything from the CP Board is waiting to be read
+//!
+//! The receiver can only wake the MCU from LPM3 when this is FALSE, so the
+//! core checks it before going to sleep.
+//!   \param None
+//!   \return TRUE if a message is waiting or partly received
+///////////////////////////////////////////////////////////////////////////////
+uint8 ucCOMM_RXPending(void)
+{
+  return (g_ucRXMessageCount != 0x00) || (g_ucRXMessageIndex != 0x00);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Checks whether the CP link is up
+//!
+//! While it is, the receiver runs off SMCLK, so nothing may sleep in LPM3
+//! for longer than a byte if a request is to get through.
+//!   \param None
+//!   \return TRUE if COMM_RUNNING is set
+///////////////////////////////////////////////////////////////////////////////
+uint8 ucCOMM_IsRunning(void)
+{
+  return (g_ucCOMM_Flags & COMM_RUNNING) != 0x00;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Waits for reception of a message
+//!
+//! Without framing, the RX ISR takes the message size from the ucMsgSize
+//! field of the message. A message that is too short is dropped here.
+//!
+//! With framing, the RX ISR hunts for the sync byte and collects a complete
+//! frame. The frame is then checked here. A frame that is too short or has
+//! a bad CRC is dropped and the CP Board is sent a NAK_PKT, so the link is
+//! back in step after one frame.
+//!
+//! If \e ucOverflows is not 0 the wait gives up after that many TimerA
+//! overflows. While waiting the system is in LPM0 and the debug UART is
+//! serviced.
+//! Longer messages, such as a BATCH_PKT while waiting for a data message, are
+//! passed on for the caller to sort out by type.
+//!   \param ucSize The smallest size of the message (in bytes)
+//!   \param ucOverflows The timeout in TimerA overflows, 0 to wait forever
+//!   \return COMM_OK or COMM_TIMEOUT
+///////////////////////////////////////////////////////////////////////////////
+uint8 ucCOMM_WaitForMessage(uint8 ucSize, uint8 ucOverflows)
+{
+#if SP_COMM_ADDRESSED
+  uint16 unAddress;
+#endif
+
+  //__bis_SR_register(LPM3_bits); //CPU asleep and all clocks except ACLK asleep.
+  //ACLK must stay on because valves may need it. If either UART has a byte or
+  //we get a start bit from the CP-board, we leave this and check if we have
+  // a complete message from CP. Then it waits for complete message (needs LPM0
+  //so we can receive message from CP-board). I wanted the UART to be checked
+  //inside this while loop in case a start bit comes while UART is being handled.
+  //(Danger of re-entering LMP3 while SMCLK timer is needed)
+  //A better code could be written with flags etc, but UART is only used in test
+  //environment so this is not OP critical.
+
+  g_ucCOMM_Flags &= ~COMM_TIMED_OUT;
+  if (ucOverflows)
+  {
+    g_ucTimeoutOverflowsLeft = ucOverflows;
+    TACTL &= ~TAIFG;
+    TACTL |= TAIE;
+  }
+
+  while (TRUE)
+  {
+    while (g_ucRXMessageCount == 0x00){
+	  //UARTDELETE
+#if !SP_FIRMWARE_UPDATE
+	  // The debug UART code is not in the BOOT link
+	  if(ucUARTCOM_getBufferFill() &&ucUARTCOM_LastIsReturn()){//Can comment this out when final code published.
+		  vUARTCOM_HandleUART();
+	  }
+#endif
+
+	  // Only sleep if the RX ISR has not finished a message since we checked
+	  __bic_SR_register(GIE);
+	  if (g_ucCOMM_Flags & COMM_TIMED_OUT)
+	  {
+	    __bis_SR_register(GIE);
+	    return COMM_TIMEOUT;
+	  }
+	  if (g_ucRXMessageCount == 0x00)
+	    __bis_SR_register(GIE + LPM0_bits); //CPU asleep.
+	  __bis_SR_register(GIE);
+    }
+
+#if SP_COMM_FRAMED
+#if SP_COMM_ADDRESSED
+    if (ucCOMM_CheckFrame(g_ucaRXMessages[g_ucRXTake], ucSize) == COMM_OK)
+    {
+      unAddress = ((uint16)g_ucaRXMessages[g_ucRXTake][COMM_FRAME_ADDRESS_INDEX] << 8) |
+                  g_ucaRXMessages[g_ucRXTake][COMM_FRAME_ADDRESS_INDEX + 1];
+
+      if (unAddress == COMM_ADDRESS)
+      {
+        g_ucCOMM_Flags &= ~COMM_BROADCAST;
+        break;
+      }
+      if (unAddress == SP_ADDRESS_BROADCAST)
+      {
+        g_ucCOMM_Flags |= COMM_BROADCAST;
+        break;
+      }
+
+      // For another SP Board on the line
+      vCOMM_ReleaseMessage();
+      continue;
+    }
+#else
+    if (ucCOMM_CheckFrame(g_ucaRXMessages[g_ucRXTake], ucSize) == COMM_OK)
+      break;
+#endif
+
+#if SP_COMM_AUTOBAUD
+    // A bad first frame most likely means a bad measurement, so measure
+    // again instead of answering at a rate the CP Board may not be using
+    if (g_ucCOMM_Flags & COMM_BAUD_UNCONFIRMED)
+    {
+      vCOMM_StartAutoBaud();
+      continue;
+    }
+#endif
+
+    // The frame is corrupt, drop it and ask for it again. On a shared line
+    // it may not have been for us, and the NAKs would collide, so the CP
+    // Board has to time out and send it again.
+    g_unCOMM_RXFramingErrors++;
+    vCOMM_ReleaseMessage();
+#if !SP_COMM_ADDRESSED
+    vCOMM_SendNAK();
+#endif
+#else
+    if (g_ucaRXMessages[g_ucRXTake][1] >= ucSize)
+      break;
+
+    // Not the message we are waiting for, drop it
+    g_unCOMM_RXFramingErrors++;
+    vCOMM_ReleaseMessage();
+#endif
+  }
+
+  TACTL &= ~TAIE;
+  g_ucCOMM_Flags &= ~COMM_BAUD_UNCONFIRMED;
+
+  return COMM_OK;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Waits for reception of a data message, with a timeout
+//!
+//! This function waits for a data message to be recieved on the serial port
+//! for at most \e ucOverflows TimerA overflows.
+//!   \param ucOverflows The timeout in TimerA overflows
+//!   \return COMM_OK or COMM_TIMEOUT
+//!   \sa ucCOMM_WaitForMessage()
+///////////////////////////////////////////////////////////////////////////////
+uint8 ucCOMM_WaitFor32BitDataMessageTimeout(uint8 ucOverflows)
+{
+  return ucCOMM_WaitForMessage(SP_32BITDATAMESSAGE_SIZE, ucOverflows);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Waits for reception of a data message
+//!
+//! This function waits for a data message to be recieved on the serial port.
+//!   \param None.
+//!   \return None.
+//!   \sa ucCOMM_WaitForMessage()
+///////////////////////////////////////////////////////////////////////////////
+void vCOMM_WaitFor32BitDataMessage(void)
+{
+  ucCOMM_WaitForMessage(SP_32BITDATAMESSAGE_SIZE, 0x00);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Waits for reception of a data message
+//!
+//! This function waits for a 128 bit data message to be recieved on the
+//! serial port.
+//!   \param None.
+//!   \return None.
+//!   \sa ucCOMM_WaitForMessage()
+///////////////////////////////////////////////////////////////////////////////
+void vCOMM_WaitFor128BitDataMessage(void)
+{
+  ucCOMM_WaitForMessage(SP_128BITDATAMESSAGE_SIZE, 0x00);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Waits for reception of a label message
+//!
+//! This function waits for a label message to be received on the serial port.
+//!   \param None.
+//!   \return None.
+//!   \sa ucCOMM_WaitForMessage()
+///////////////////////////////////////////////////////////////////////////////
+void vCOMM_WaitForLabelMessage(void)
+{
+  ucCOMM_WaitForMessage(SP_LABELMESSAGE_SIZE, 0x00);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Sends a message on the serial port
+//!
+//! The message is kept, with the SEQ of the request it answers, so it can be
+//! sent again if the CP Board answers with a NAK_PKT or repeats the request.
+//! It is then sent in a frame or as bare bytes depending on SP_COMM_FRAMED.
+//!   \param p_ucMessage Pointer to the message bytes
+//!   \param ucSize The number of message bytes
+//!   \return None
+//!   \sa vCOMM_ResendLastMessage()
+///////////////////////////////////////////////////////////////////////////////
+void vCOMM_SendMessage(uint8 * p_ucMessage, uint8 ucSize)
+{
+  uint8 ucLoopCount;
+
+  for (ucLoopCount = 0x00; ucLoopCount < ucSize; ucLoopCount++)
+    g_ucaTXLastMessage[ucLoopCount] = p_ucMessage[ucLoopCount];
+  g_ucTXLastMessageSize = ucSize;
+
+#if SP_COMM_FRAMED
+  g_ucTXLastSequence = g_ucCOMM_TXSequence;
+  vCOMM_SendFrame(p_ucMessage, ucSize);
+#else
+  for (ucLoopCount = 0x00; ucLoopCount < ucSize; ucLoopCount++)
+    vCOMM_SendByte(p_ucMessage[ucLoopCount]);
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Sends the last message again
+//!
+//! This is the answer to a NAK_PKT from the CP Board or to a repeated
+//! request. The message goes out with the SEQ it was first sent with.
+//! Nothing is sent if no message has been sent yet.
+//!   \param None
+//!   \return None
+//!   \sa vCOMM_SendMessage()
+///////////////////////////////////////////////////////////////////////////////
+void vCOMM_ResendLastMessage(void)
+{
+  if (g_ucTXLastMessageSize)
+  {
+#if SP_COMM_FRAMED
+    g_ucCOMM_TXSequence = g_ucTXLastSequence;
+#endif
+    vCOMM_SendMessage(g_ucaTXLastMessage, g_ucTXLastMessageSize);
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Sends a data message on the serial port
+//!
+//! This function sends the data message pointed to by \e p_DataMessage on the
+//! software UART line
+//!   \param p_DataMessage Pointer to the message to send
+//!   \return None
+///////////////////////////////////////////////////////////////////////////////.
+void vCOMM_Send32BitDataMessage(union SP_32BitDataMessage * p_32BitDataMessage)
+{
+  vCOMM_SendMessage(p_32BitDataMessage->ucByteStream, SP_32BITDATAMESSAGE_SIZE);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Sends a REPORT_NO_CHANGE on the serial port
+//!
+//! Only the header of a data message is sent.
+//!   \param ucSensorNumber The transducer the report is for
+//!   \return None
+///////////////////////////////////////////////////////////////////////////////
+void vCOMM_SendNoChange(uint8 ucSensorNumber)
+{
+  union SP_32BitDataMessage NoChangeMsg;
+
+  NoChangeMsg.fields.ucMsgVersion = SP_DATAMESSAGE_VERSION;
+  NoChangeMsg.fields.ucMsgSize = SP_NOCHANGEMESSAGE_SIZE;
+  NoChangeMsg.fields.ucMsgType = REPORT_NO_CHANGE;
+  NoChangeMsg.fields.ucSensorNumber = ucSensorNumber;
+
+  vCOMM_SendMessage(NoChangeMsg.ucByteStream, SP_NOCHANGEMESSAGE_SIZE);
+}
+
+#if SP_PACKET_SIZE_128
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Sends a data return message on the serial port
+//! Written by -scb
+//!
+//! This function sends the data message pointed to by \e p_DataMessage on the
+//! software UART line
+//!   \param p_DataMessage Pointer to the message to send
+//!   \return None
+///////////////////////////////////////////////////////////////////////////////
+
+void vCOMM_Send128BitDataMessage(union SP_128BitDataMessage * p_128BitDataMessage)
+{
+  vCOMM_SendMessage(p_128BitDataMessage->ucByteStream, SP_128BITDATAMESSAGE_SIZE);
+}
+#endif
+
+#if SP_PACKET_VARIABLE
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Sends a variable length data message on the serial port
+//!
+//! Only the first ucMsgSize bytes of the message pointed to by
+//! \e p_VarDataMessage are sent, so ucMsgSize must already be filled in.
+//!   \param p_VarDataMessage Pointer to the message to send
+//!   \return None
+///////////////////////////////////////////////////////////////////////////////
+void vCOMM_SendVarDataMessage(union SP_VarDataMessage * p_VarDataMessage)
+{
+  vCOMM_SendMessage(p_VarDataMessage->ucByteStream,
+                    p_VarDataMessage->fields.ucMsgSize);
+}
+#endif
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Sends a REPORT_BATCH on the serial port
+//!
+//! Only the first ucMsgSize bytes of the message pointed to by
+//! \e p_BatchReport are sent, so ucMsgSize must already be filled in.
+//!   \param p_BatchReport Pointer to the message to send
+//!   \return None
+///////////////////////////////////////////////////////////////////////////////
+void vCOMM_SendBatchReport(union SP_BatchReportMessage * p_BatchReport)
+{
+  vCOMM_SendMessage(p_BatchReport->ucByteStream,
+                    p_BatchReport->fields.ucMsgSize);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Sends a label message on the serial port
+//!
+//! This function sends the label message pointed to by \e p_LabelMessage on
+//! the software UART line
+//!   \param p_LabelMessage Pointer to the message to send
+//!   \return None.
+///////////////////////////////////////////////////////////////////////////////
+void vCOMM_SendLabelMessage(union SP_LabelMessage * p_LabelMessage)
+{
+  vCOMM_SendMessage(p_LabelMessage->ucByteStream, SP_LABELMESSAGE_SIZE);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Clears the link statistics
+//!
+//! The drift is kept, it is a measurement and not a count. The caller must
+//! keep the ISRs out while the counters are cleared.
+//!   \param None
+//!   \return None
+//!   \sa vCOMM_SendLinkStatus()
+///////////////////////////////////////////////////////////////////////////////
+void vCOMM_ClearLinkStatus(void)
+{
+  g_unCOMM_RXOverruns = 0x0000;
+  g_unCOMM_RXFramingErrors = 0x0000;
+  g_unCOMM_RXStopBitErrors = 0x0000;
+  g_unCOMM_RXBytes = 0x0000;
+  g_unCOMM_TXBytes = 0x0000;
+#if SP_COMM_FRAMED
+  g_unCOMM_RXCRCErrors = 0x0000;
+#endif
+#if SP_COMM_LATENCY_STATS
+  g_unCOMM_ISRLatencyMax = 0x0000;
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Reports the link statistics to the CP Board
+//!
+//! Sends a REPORT_LINK_STATUS with the error and byte counters, the drift
+//! of the CP Board bit period and, with SP_COMM_LATENCY_STATS, the worst
+//! ISR latency.
+//!   \param ucClear If not 0 the counters are cleared once they are copied
+//!   \return None
+//!   \sa REPORT_LINK_STATUS
+///////////////////////////////////////////////////////////////////////////////
+void vCOMM_SendLinkStatus(uint8 ucClear)
+{
+  union SP_128BitDataMessage StatusMsg;
+  uint8 ucLoopCount;
+
+  for (ucLoopCount = 0x00; ucLoopCount < SP_128BITDATAMESSAGE_SIZE; ucLoopCount++)
+    StatusMsg.ucByteStream[ucLoopCount] = 0x00;
+
+  StatusMsg.fields.ucMsgVersion = SP_DATAMESSAGE_VERSION;
+  StatusMsg.fields.ucMsgSize = SP_128BITDATAMESSAGE_SIZE;
+  StatusMsg.fields.ucMsgType = REPORT_LINK_STATUS;
+  StatusMsg.fields.ucSensorNumber = REPORT_LINK_STATUS;
+
+  // The ISR must not count between the copy and the clear
+  __bic_SR_register(GIE);
+
+  StatusMsg.fields.ucData1_HI_BYTE = (uint8)(g_unCOMM_RXOverruns >> 8);
+  StatusMsg.fields.ucData1_LO_BYTE = (uint8)g_unCOMM_RXOverruns;
+  StatusMsg.fields.ucData2_HI_BYTE = (uint8)(g_unCOMM_RXFramingErrors >> 8);
+  StatusMsg.fields.ucData2_LO_BYTE = (uint8)g_unCOMM_RXFramingErrors;
+  StatusMsg.fields.ucData3_HI_BYTE = (uint8)(g_unCOMM_RXStopBitErrors >> 8);
+  StatusMsg.fields.ucData3_LO_BYTE = (uint8)g_unCOMM_RXStopBitErrors;
+  StatusMsg.fields.ucData4_HI_BYTE = (uint8)(g_unCOMM_RXBytes >> 8);
+  StatusMsg.fields.ucData4_LO_BYTE = (uint8)g_unCOMM_RXBytes;
+  StatusMsg.fields.ucData5_HI_BYTE = (uint8)(g_unCOMM_TXBytes >> 8);
+  StatusMsg.fields.ucData5_LO_BYTE = (uint8)g_unCOMM_TXBytes;
+#if SP_COMM_FRAMED
+  StatusMsg.fields.ucData6_HI_BYTE = (uint8)(g_unCOMM_RXCRCErrors >> 8);
+  StatusMsg.fields.ucData6_LO_BYTE = (uint8)g_unCOMM_RXCRCErrors;
+#endif
+  StatusMsg.fields.ucData7_HI_BYTE = (uint8)((uint16)g_iCOMM_RXByteDrift >> 8);
+  StatusMsg.fields.ucData7_LO_BYTE = (uint8)g_iCOMM_RXByteDrift;
+#if SP_COMM_LATENCY_STATS
+  StatusMsg.fields.ucData8_HI_BYTE = (uint8)(g_unCOMM_ISRLatencyMax >> 8);
+  StatusMsg.fields.ucData8_LO_BYTE = (uint8)g_unCOMM_ISRLatencyMax;
+#endif
+
+  if (ucClear)
+    vCOMM_ClearLinkStatus();
+
+  __bis_SR_register(GIE);
+
+  vCOMM_SendMessage(StatusMsg.ucByteStream, SP_128BITDATAMESSAGE_SIZE);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Grabs the raw chars from buffer into a message
+//!
+//! This function copies the oldest message out of its RX message buffer,
+//! skipping the frame header if there is one, and releases the buffer.
+//!   \param p_ucMessage Pointer to the message bytes
+//!   \param ucSize The size of the message (in bytes)
+//!   \return The error code indicating the status after call
+//!   \sa comm.h msg.h
+///////////////////////////////////////////////////////////////////////////////
+uint8 ucCOMM_GrabMessageFromBuffer(uint8 * p_ucMessage, uint8 ucSize)
+{
+  uint8 ucLoopCount;
+
+  if (g_ucRXMessageCount == 0x00)
+    return COMM_BUFFER_UNDERFLOW;
+
+  for (ucLoopCount = 0x00; ucLoopCount < ucSize; ucLoopCount++)
+    p_ucMessage[ucLoopCount] = g_ucaRXMessages[g_ucRXTake][ucLoopCount + COMM_MESSAGE_OFFSET];
+
+  vCOMM_ReleaseMessage();
+
+  return COMM_OK;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Grabs the raw chars from buffer and formats into a data message
+//!
+//! This function takes the characters from the RX message buffer and formats and
+//! stores them in the data message pointed to by \e message.
+//!   \param message Pointer to the message
+//!   \return The error code indicating the status after call
+//!   \sa comm.h msg.h
+///////////////////////////////////////////////////////////////////////////////
+uint8 ucCOMM_Grab32BitDataMessageFromBuffer(union SP_32BitDataMessage * message)
+{
+  return ucCOMM_GrabMessageFromBuffer(message->ucByteStream, SP_32BITDATAMESSAGE_SIZE);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Grabs the raw chars from buffer and formats into a data message
+//!
+//! This function takes the characters from the RX message buffer and formats and
+//! stores them in the data message pointed to by \e message.
+//!   \param message Pointer to the message
+//!   \return The error code indicating the status after call
+//!   \sa comm.h msg.h
+///////////////////////////////////////////////////////////////////////////////
+uint8 ucCOMM_Grab128BitDataMessageFromBuffer(union SP_128BitDataMessage * message)
+{
+  return ucCOMM_GrabMessageFromBuffer(message->ucByteStream, SP_128BITDATAMESSAGE_SIZE);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Grabs the raw chars from buffer and formats into a label message
+//!
+//! This function takes the characters from the RX message buffer and formats and
+//! stores them in the label message pointed to by \e message.
+//!   \param message Pointer to the label message
+//!   \return The error code indicatin the status of the call
+//!   \sa comm.h msg.h
+///////////////////////////////////////////////////////////////////////////////
+uint8 ucCOMM_GrabLabelMessageFromBuffer(union SP_LabelMessage * message)
+{
+  return ucCOMM_GrabMessageFromBuffer(message->ucByteStream, SP_LABELMESSAGE_SIZE);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Takes the oldest data message without copying it
+//!
+//! The message stays in its RX message buffer, which belongs to the caller
+//! until \e vCOMM_ReleaseMessage(). The reply can be built in the same
+//! buffer, it is copied out when it is sent. The RX ISR fills the other
+//! buffer in the meantime.
+//!   \param None
+//!   \return Pointer to the message, or NULL if there is none
+//!   \sa ucCOMM_WaitForMessage(), vCOMM_ReleaseMessage()
+///////////////////////////////////////////////////////////////////////////////
+union SP_32BitDataMessage * p_COMM_Take32BitDataMessage(void)
+{
+  if (g_ucRXMessageCount == 0x00)
+    return NULL;
+
+  return (union SP_32BitDataMessage *)&g_ucaRXMessages[g_ucRXTake][COMM_MESSAGE_OFFSET];
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Checks whether the message taken repeats the last request
+//!
+//! Call this once for each message taken with
+//! \e p_COMM_Take32BitDataMessage(). The replies sent from here on carry the
+//! SEQ of the message. If the SEQ is the one the reply in
+//! g_ucaTXLastMessage was sent with, the CP Board did not get that reply.
+//! A request that was not answered, such as a TRIGGER_PKT or an
+//! UPDATE_DATA_PKT, is handled again when it is repeated. Without framing
+//! there is no SEQ and no request is a repeat.
+//!   \param None
+//!   \return TRUE if the last reply should be sent again instead of handling
+//!   the message, FALSE otherwise
+//!   \sa vCOMM_ResendLastMessage(), vCOMM_ForgetRequest(), msg_frame
+///////////////////////////////////////////////////////////////////////////////
+uint8 ucCOMM_IsRepeatedRequest(void)
+{
+#if SP_COMM_FRAMED
+  uint8 ucSequence;
+
+  ucSequence = g_ucaRXMessages[g_ucRXTake][COMM_FRAME_SEQ_INDEX];
+  g_ucCOMM_TXSequence = ucSequence;
+
+  if (ucSequence == SP_FRAME_SEQ_NONE)
+    return FALSE;
+
+  if ((ucSequence == g_ucTXLastSequence) && g_ucTXLastMessageSize)
+    return TRUE;
+#endif
+  return FALSE;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Makes a repeat of the last request get handled again
+//!
+//! For requests that are answered with more than one message, where the
+//! last message alone is not the whole reply.
+//!   \param None
+//!   \return None
+//!   \sa ucCOMM_IsRepeatedRequest()
+///////////////////////////////////////////////////////////////////////////////
+void vCOMM_ForgetRequest(void)
+{
+#if SP_COMM_FRAMED
+  g_ucTXLastSequence = SP_FRAME_SEQ_NONE;
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief TimerA0 ISR, sends and receives on the software UART lines
+//!
+//! TimerA free-runs and CCR0 has been configured by \e vCOMM_SendByte() or
+//! \e vCOMM_ArmReceiver() for the bit timing on a specific baud rate. Each
+//! compare is scheduled one bit period after the previous one, so the ISR
+//! only has to be done before the next bit edge, not at it.
+//!
+//! For TX the ISR sets the Out0 output mode for the next bit: OUTMOD_1 sets
+//! the pin on the next compare and OUTMOD_5 resets it. The pin changes in
+//! hardware, so the latency of this ISR does not show up on the line. While
+//! the stop bit is on the line the next byte is taken off the TX ring
+//! buffer, so there is no gap between the bytes of a message.
+//!
+//! For RX, a capture (or \e PORT2_ISR()) marks the falling edge of a start
+//! bit. CCR0 is moved to the middle of the start bit and switched to compare
+//! mode. On each compare the synchronized input (SCCI) holds the value of
+//! the RX pin latched at the compare. The first sample must still be low,
+//! otherwise the start bit is dropped as a glitch. The samples after it are
+//! shifted into \e g_ucRXShift, and the byte goes into the message buffer
+//! being filled if the stop bit is high. A low stop bit is counted in the
+//! \ref comm "Link Statistics".
+//!
+//! In half-duplex this ISR handles the timing for both TX and RX on CCR0.
+//! In full-duplex it only handles RX, TX is done by \e TIMERA1_ISR().
+//!
+//! NOTE: This interrupt is ONLY for handling CCR0. In half-duplex the user
+//! can have the TIMERA1 interrupt for other uses of TA CCR1, CCR2 and TAIFG
+//!   \param None
+//!   \return None
+//!   \sa vCOMM_Init(), vCOMM_SendByte(), vCOMM_ArmReceiver()
+///////////////////////////////////////////////////////////////////////////////
+#pragma vector=TIMERA0_VECTOR
+__interrupt void TIMERA0_ISR(void)
+{
+  uint16 unTicks;
+
+#if SP_COMM_LATENCY_STATS
+  // TACCR0 still holds the time of the compare or capture that got us here
+  unTicks = TAR - TACCR0;
+  if (unTicks > g_unCOMM_ISRLatencyMax)
+    g_unCOMM_ISRLatencyMax = unTicks;
+#endif
+
+#if !SP_COMM_FULL_DUPLEX
+  if (g_ucCOMM_Flags & COMM_TX_BUSY)
+  {
+    // Schedule the next bit edge, a tick later if the fraction carries
+    g_unTXBitFraction = (uint8)g_unTXBitFraction + g_ucCOMM_BaudRateFraction;
+    TACCR0 += g_unCOMM_BaudRateControl + (g_unTXBitFraction >> 8);
+
+    if (g_ucTXBitsLeft == 0x00)
+    {
+      // The stop bit is done and nothing is queued, hold the line in the idle
+      // state
+      TACCTL0 = OUT;
+      g_ucCOMM_Flags &= ~COMM_TX_BUSY;
+      COMM_TX_RELEASE();
+      vCOMM_ArmReceiver();
+      __bic_SR_register_on_exit(LPM0_bits);
+    }
+    else if ((g_ucTXBitsLeft == 0x01) &&
+             (g_ucTXBufferTail != g_ucTXBufferHead))
+    {
+      // The stop bit is on the line, the next start bit follows it directly.
+      // Wake anyone waiting on room in the buffer.
+      vCOMM_LoadNextTXByte();
+      __bic_SR_register_on_exit(LPM0_bits);
+    }
+    else
+    {
+      // Set up the output unit for the next bit and shift for next time
+      if (g_unTXBuffer & 0x01)
+        TACCTL0 = OUTMOD_1 | CCIE;
+      else
+        TACCTL0 = OUTMOD_5 | CCIE;
+
+      g_unTXBuffer >>= 1;
+
+      // Decrement the total bit count
+      g_ucTXBitsLeft--;
+    }
+    return;
+  }
+#endif
+
+  if (TACCTL0 & CAP)
+  {
+#if SP_COMM_AUTOBAUD
+    if (g_ucCOMM_Flags & COMM_AUTOBAUD)
+    {
+      if (g_ucAutoBaudEdgesLeft == g_ucAutoBaudEdges)
+        g_unAutoBaudStart = TACCR0;
+
+      if (--g_ucAutoBaudEdgesLeft)
+        return;
+
+      // This edge is the start of bit 7, 8 bit periods after the start bit.
+      // The 32 bit math of vCOMM_SetBitPeriod() is too slow for here.
+      g_unAutoBaudStart = TACCR0 - g_unAutoBaudStart;
+      g_unCOMM_BaudRateControl = g_unAutoBaudStart >> 3;
+      g_ucCOMM_BaudRateFraction = (uint8)(g_unAutoBaudStart << 5);
+      g_unCOMM_BaudRateDelayControl = g_unAutoBaudStart >> 4;
+      g_ucCOMM_BaudRateDelayFraction = (uint8)(g_unAutoBaudStart << 4);
+      g_unCOMM_BytePeriod = g_unAutoBaudStart + (g_unAutoBaudStart >> 2);
+      g_ucCOMM_Flags &= ~COMM_AUTOBAUD;
+
+      // Bits 0 to 6 are known, sample bit 7 and the stop bit as usual
+      g_ucRXShift = COMM_AUTOBAUD_BYTE & 0x7F;
+      g_unRXBitFraction = g_ucCOMM_BaudRateDelayFraction;
+      TACCR0 += g_unCOMM_BaudRateDelayControl;
+      TACCTL0 = RX_CCIS | SCS | CCIE | OUT;
+      g_ucCOMM_Flags |= COMM_RX_BUSY;
+      g_ucRXBitsLeft = 0x01;
+#if SP_COMM_FRAMED
+      // 10 bit periods, 1.25 times the 8 just measured
+      if (g_unAutoBaudStart > 0xCCCC)
+        g_unCOMM_ByteTimeControl = 0xFFFF;
+      else
+        g_unCOMM_ByteTimeControl = g_unAutoBaudStart + (g_unAutoBaudStart >> 2);
+#endif
+      vCOMM_SetPortStartDelays();
+      return;
+    }
+#endif
+
+    // A start bit right behind the last byte is 10 bit periods of the CP
+    // Board after the last one. Anything more than half a bit off is a gap.
+    if (g_ucRXLastStartValid)
+    {
+      unTicks = TACCR0 - g_unRXLastStart - g_unCOMM_BytePeriod;
+      if ((unTicks + g_unCOMM_BaudRateDelayControl) < (g_unCOMM_BaudRateDelayControl << 1))
+        g_iCOMM_RXByteDrift = (int16)unTicks;
+    }
+    g_unRXLastStart = TACCR0;
+    g_ucRXLastStartValid = TRUE;
+
+    // Captured a start bit, check it again in the middle of the bit
+    g_unRXBitFraction = g_ucCOMM_BaudRateDelayFraction;
+    TACCR0 += g_unCOMM_BaudRateDelayControl;
+    TACCTL0 = RX_CCIS | SCS | CCIE | OUT;
+    g_ucCOMM_Flags |= COMM_RX_BUSY;
+    g_ucRXBitsLeft = 0x09;
+    return;
+  }
+
+  if (g_ucCOMM_Flags & COMM_RX_BUSY)
+  {
+    // Schedule the next sample, a tick later if the fraction carries
+    g_unRXBitFraction = (uint8)g_unRXBitFraction + g_ucCOMM_BaudRateFraction;
+    TACCR0 += g_unCOMM_BaudRateControl + (g_unRXBitFraction >> 8);
+
+    switch(g_ucRXBitsLeft)
+    {
+      case 0x00:
+        // This is the stop bit, a byte with a low stop bit is dropped
+        if (!(TACCTL0 & SCCI))
+          g_unCOMM_RXStopBitErrors++;
+        else
+          vCOMM_PutRXByte(g_ucRXShift);
+
+#if SP_COMM_FRAMED
+        // Restart the inter-byte timeout
+        TACCR2 = TAR + g_unCOMM_ByteTimeControl;
+        g_ucRXTimeoutLeft = COMM_RX_TIMEOUT_BYTES;
+        TACCTL2 = CCIE;
+#endif
+        g_ucCOMM_Flags &= ~COMM_RX_BUSY;
+        vCOMM_ArmReceiver();
+        //Set All Clocks and CPU etc awake now that we received a byte. (check if it's last later)
+        //If it is not the last Byte, the core will put us back into LPM0, which won't stop the clocks, just the CPU
+        break;
+
+      case 0x09:
+        // Middle of the start bit, if the line is back high it was a glitch
+        if (TACCTL0 & SCCI)
+        {
+          g_ucCOMM_Flags &= ~COMM_RX_BUSY;
+          vCOMM_ArmReceiver();
+        }
+        break;
+
+      case 0x01:
+        if (TACCTL0 & SCCI)
+          g_ucRXShift |= 0x80;
+        else
+          g_ucRXShift &= ~0x80;
+
+        break;
+
+      default:
+        if (TACCTL0 & SCCI)
+          g_ucRXShift |= 0x80;
+        else
+          g_ucRXShift &= ~0x80;
+
+        g_ucRXShift >>= 1;
+        break;
+    }
+    g_ucRXBitsLeft--;
+  }
+
+  if(!(g_ucCOMM_Flags & COMM_RX_BUSY) && !(g_ucCOMM_Flags & COMM_TX_BUSY))
+  {
+	  __bic_SR_register_on_exit(LPM4_bits); //Exit LPM if it was neither RX nor TX
+  }
+
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief TimerA1 ISR, sends on the software UART TX line and times out RX
+//!
+//! In full-duplex the transmitter has its own schedule on CCR1, so a reply
+//! can go out while the receiver is still busy on CCR0. TA1 is not brought
+//! out on the TX pin, so the pin is written in software. The next bit is
+//! already in bit 0 of the shift register and is put on the line before
+//! anything else is done, so the edge only lags the compare by the
+//! interrupt latency. When the stop bit is on the line, the next byte is
+//! taken off the TX ring buffer, so its start bit follows the stop bit with
+//! no gap.
+//!
+//! With framing, CCR2 ticks once per byte time after each received byte.
+//! If the line stays quiet for \ref COMM_RX_TIMEOUT_BYTES byte times in the
+//! middle of a frame, the partial frame is dropped and the receiver goes
+//! back to hunting for the sync byte.
+//!
+//! The TimerA overflow counts down a timed wait for a message.
+//!
+//! The other TAIV sources are left for future use.
+//!   \param None
+//!   \return None
+//!   \sa vCOMM_SendByte(), vCOMM_LoadNextTXByte()
+///////////////////////////////////////////////////////////////////////////////
+#pragma vector=TIMERA1_VECTOR
+__interrupt void TIMERA1_ISR(void)
+{
+#if SP_COMM_FULL_DUPLEX && SP_COMM_LATENCY_STATS
+  uint16 unTicks;
+#endif
+
+  switch(TAIV)
+  {
+#if SP_COMM_FULL_DUPLEX
+    case 0x02:
+      // Put the bit on the line first, the rest is book keeping
+      if (g_unTXBuffer & 0x01)
+        P_TX_OUT |= TX_PIN;
+      else
+        P_TX_OUT &= ~TX_PIN;
+
+#if SP_COMM_LATENCY_STATS
+      // The latency includes the pin write, which is what TX jitter is
+      unTicks = TAR - TACCR1;
+      if (unTicks > g_unCOMM_ISRLatencyMax)
+        g_unCOMM_ISRLatencyMax = unTicks;
+#endif
+
+      g_unTXBuffer >>= 1;
+      g_unTXBitFraction = (uint8)g_unTXBitFraction + g_ucCOMM_BaudRateFraction;
+      TACCR1 += g_unCOMM_BaudRateControl + (g_unTXBitFraction >> 8);
+
+      if (--g_ucTXBitsLeft == 0x00)
+      {
+        // The stop bit is on the line, the line is idle after it
+        if (g_ucTXBufferTail != g_ucTXBufferHead)
+        {
+          vCOMM_LoadNextTXByte();
+        }
+        else
+        {
+          // The pull up finishes the stop bit on a shared line
+          TACCTL1 = 0x0000;
+          g_ucCOMM_Flags &= ~COMM_TX_BUSY;
+          COMM_TX_RELEASE();
+        }
+
+        // Wake anyone waiting on room in the buffer or the end of TX
+        __bic_SR_register_on_exit(LPM0_bits);
+      }
+      break;
+#endif
+
+#if SP_COMM_FRAMED
+    case 0x04:
+      TACCR2 += g_unCOMM_ByteTimeControl;
+      // The line has been quiet for a byte time, the next start bit does
+      // not follow the last byte back to back
+      g_ucRXLastStartValid = FALSE;
+
+      if (g_ucRXTimeoutLeft > 0x01)
+      {
+        g_ucRXTimeoutLeft--;
+      }
+      else if (!(g_ucCOMM_Flags & COMM_RX_BUSY))
+      {
+        // The line went quiet, drop any partial frame and hunt for the next
+        // sync byte. If a byte is on its way in it restarts the timeout.
+        TACCTL2 = 0x0000;
+        if (g_ucRXMessageIndex)
+        {
+          g_unCOMM_RXFramingErrors++;
+          g_ucRXMessageIndex = 0x00;
+          vCOMM_ArmReceiver();
+        }
+      }
+      break;
+#endif
+
+    case 0x0A:
+      // TimerA overflow, one tick of a timed wait
+      if (--g_ucTimeoutOverflowsLeft == 0x00)
+      {
+        TACTL &= ~TAIE;
+        g_ucCOMM_Flags |= COMM_TIMED_OUT;
+        __bic_SR_register_on_exit(LPM4_bits);
+      }
+      break;
+
+    default:
+      break;
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Port2 ISR, handles the start of the UART RX
+//!
+//! The idle state for UART is line high, thus when we get the falling edge
+//! indicating the start bit, we can hand the sampling over to TimerA. This
+//! path is only used for the first byte of a message, since TimerA does not
+//! run in LPM3. The SMCLK is back up by the time we get here, so the RX pin
+//! is given to the capture/compare unit and the first sample, in the middle
+//! of the start bit, is scheduled on CCR0. The ISR returns right away and
+//! the TimerA0 ISR does the rest, so other interrupts are not held off for
+//! the half bit.
+//!
+//! The half bit is counted from the TAR read at the top of the ISR, less the
+//! latency measured by vCOMM_MeasureWakeLatency(). If the start bit woke the
+//! MCU from LPM3 or LPM4 the DCO start time is taken off as well.
+//!   \param None
+//!   \return None
+//!   \sa vCOMM_ArmReceiver(), TIMERA0_ISR
+///////////////////////////////////////////////////////////////////////////////
+#pragma vector=PORT2_VECTOR
+__interrupt void PORT2_ISR(void)
+{
+   uint16 unNow;
+
+   // Read first, so the time to here is the same on every path
+   unNow = TAR;
+
+   if (g_ucCOMM_Flags & COMM_WAKE_CAL)
+   {
+      g_unCOMM_WakeLatency = unNow - g_unCOMM_WakeLatency;
+      g_ucCOMM_Flags &= ~COMM_WAKE_CAL;
+      P_RX_IFG &= ~RX_PIN;
+      __bic_SR_register_on_exit(LPM4_bits);
+      return;
+   }
+
+   // Determine the source of the interrupt
+   // If we get an interrupt from the RX pin, then we have RXed a start bit
+   if((P_RX_IFG & RX_PIN) && (P_RX_IE & RX_PIN))//P2IFG & BIT2
+   {
+	  if(!(RX_PIN & P_RX_IN))
+	  {
+      // Disable interrupt on RX and give the pin to the timer
+      P_RX_IE &= ~RX_PIN;
+      P_RX_SEL |= RX_PIN;
+
+      // Delay for half bit, this ensures we start sampling at the middle of
+      // each bit
+      g_unRXBitFraction = g_ucCOMM_BaudRateDelayFraction;
+      if (__get_SR_register_on_exit() & SCG1)
+        TACCR0 = unNow + g_unCOMM_PortWakeStartDelay;
+      else
+        TACCR0 = unNow + g_unCOMM_PortStartDelay;
+      TACCTL0 = RX_CCIS | SCS | CCIE | OUT;
+      g_ucCOMM_Flags |= COMM_RX_BUSY;
+      g_ucRXBitsLeft = 0x09;
+	  }
+
+      //Clear Interrupt Flag
+      P_RX_IFG &= ~RX_PIN;
+
+      __bic_SR_register_on_exit(LPM4_bits); //All Clocks and CPU etc awake now that we received a start bit.
+
+   }//END if(P_RX_IFG & RX_PIN)//P2IFG & BIT2
+
+
+   if(P_RX_IFG & INT_PIN)//P2IFG & BIT0
+   {
+	   __bic_SR_register_on_exit(LPM4_bits); //All Clocks and CPU etc awake if interrupt called.
+   }//END if(P_RX_IFG & INT_PIN)
+
+}//END __interrupt void PORT2_ISR(void)
+
+//! @}
+//! @}
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
@@ -1,167 +1,236 @@
-///////////////////////////////////////////////////////////////////////////////
-//! \file comm.h
-//! \brief Header file for the software UART module
-//!
-//! This file provides all of the defines and function prototypes for the
-//! \ref comm Module.
-//!
-//! @addtogroup core
-//! @{
-//!
-//! @addtogroup comm Software UART
-//! The software UART module allows the user to define a UART interface on
-//! any two GPIO pins, provided that the RX pin is interrupt capable. The
-//! module requires the use of TimerA.
-//! @{
-///////////////////////////////////////////////////////////////////////////////
-//*****************************************************************************
-// By: Kenji Yamamoto
-//     Wireless Networks Research Lab
-//     Dept. of Electrical Engineering, CEFNS
-//     Northern Arizona University
-//
-//*****************************************************************************
-
-#ifndef COMM_H_
-  #define COMM_H_
-
-  //! \def RX_BUFFER_SIZE
-  //! \brief The number of bytes to allocate for the UART RX buffer
-  #define RX_BUFFER_SIZE 0x20
-
-  // Status Flags
-  //! \name Status Flags
-  //! These are bit defines that are used to set and clear the
-  //! g_ucCOMM_Flags register.
-  //! @{
-  //! \def COMM_RUNNING
-  //! \brief Bit define - Indicates UART is running
-  #define COMM_RUNNING 0x01
-  //! \def COMM_TX_BUSY
-  //! \brief Bit define - Indicates TX in progress
-  #define COMM_TX_BUSY 0x02
-  //! \def COMM_RX_BUSY
-  //! \brief Bit define - Indicates RX in progress
-  #define COMM_RX_BUSY 0x04
-
-  //! @}
-
-  // Baud rate defines
-  //! @name Baud Rate Defines
-  //! These values are computed for a 4MHz SMCLK to produce the corresponding
-  //! baud rates
-  //! @{
-  //! \def BAUD_460800
-  //! \brief Timer count for specific UART data rate, computed for 4Mhz SMCLK
-  #define BAUD_460800 0x0008
-  //! \def BAUD_345600
-  //! \brief Timer count for specific UART data rate, computed for 4Mhz SMCLK
-  #define BAUD_345600 0x000B
-  //! \def BAUD_230400
-  //! \brief Timer count for specific UART data rate, computed for 4Mhz SMCLK
-  #define BAUD_230400 0x0011
-  //! \def BAUD_115200
-  //! \brief Timer count for specific UART data rate, computed for 4Mhz SMCLK
-  #define BAUD_115200 0x0023
-  //! \def BAUD_57600
-  //! Timer count for specific UART data rate, computed for 4Mhz SMCLK
-  #define BAUD_57600  0x0045
-  //! \def BAUD_19200
-  //! Timer count for specific UART data rate, computed for 4Mhz SMCLK
-  #define BAUD_19200  0x00D0
-  //! \def BAUD_9600
-  //! Timer count for specific UART data rate, computed for 4Mhz SMCLK
-  #define BAUD_9600   0x01A0
-  //! \def BAUD_1200
-  //! Timer count for specific UART data rate, computed for 4Mhz SMCLK
-  #define BAUD_1200   0x0D05 //3333
-  //! @}
-
-//******************  Baud Rate Delays  *************************************//
-//! @name Baud Rate Start Delays
-//! These values are used to delay from the start bit to the middle of the
-//! first data bit. Computed for a 4MHz SMCLK.
-//! @{
-//! \def BAUD_460800_DELAY
-//! \brief Timer count for specific data rate delay, computed for 4Mhz SMCLK.
-#define BAUD_460800_DELAY  0x0004
-//! \def BAUD_345600_DELAY
-//! \brief Timer count for specific data rate delay, computed for 4Mhz SMCLK.
-#define BAUD_345600_DELAY  0x0006
-//! \def BAUD_230400_DELAY
-//! \brief Timer count for specific data rate delay, computed for 4Mhz SMCLK.
-#define BAUD_230400_DELAY  0x0007//Slightly low to account for the set-up cycles that we delayed. At these times that's necessary...
-//! \def BAUD_115200_DELAY
-//! \brief Timer count for specific data rate delay, computed for 4Mhz SMCLK.
-#define BAUD_115200_DELAY  0x0010//Slightly low to account for the set-up cycles that we delayed. At these times that's necessary...
-//! \def BAUD_57600_DELAY
-//! \brief Timer count for specific data rate delay, computed for 4Mhz SMCLK.
-#define BAUD_57600_DELAY   0x0022
-//! \def BAUD_19200_DELAY
-//! \brief Timer count for specific data rate delay, computed for 4Mhz SMCLK.
-#define BAUD_19200_DELAY   0x0068
-//! \def BAUD_9600_DELAY
-//! \brief Timer count for specific data rate delay, computed for 4Mhz SMCLK.
-#define BAUD_9600_DELAY    0x00D0
-//! \def BAUD_9600_DELAY
-//! \brief Timer count for specific data rate delay, computed for 4Mhz SMCLK.
-#define BAUD_1200_DELAY    0x0682 //1666
-//! @}
-
-
-  // Return codes
-  //! \name Return Codes
-  //! Possible return codes from the \ref comm functions
-  //! @{
-  //! \def COMM_BUFFER_UNDERFLOW
-  //! \brief Function return code
-  //!
-  //! Getting this return code means that the user has tried to pull more
-  //! data that is avalibe from g_ucaRXBuffer
-  #define COMM_BUFFER_UNDERFLOW 0x01
-  //! \def COMM_OK
-  //! \brief Function return code
-  #define COMM_OK               0x00
-  //! @}
-
-
-  // Comm.c function prototypes
-  //! @name Control Functions
-  //! These functions handle controlling the \ref comm Module.
-  //! @{
-  void vCOMM_Init(uint16 ucBaud);
-  void vCOMM_Shutdown(void);
-  void vCOMM_WaitFor32BitDataMessage(void);
-  void vCOMM_WaitFor128BitDataMessage(void);
-  void vCOMM_WaitForLabelMessage(void);
-  //! @}
-
-  //! @name Transmit Functions
-  //! These functions transmit information on the \ref comm Module.
-  //! @{
-  void vCOMM_SendByte(uint8 ucChar);
-  void vCOMM_Send32BitDataMessage(union SP_32BitDataMessage * p_DataMessage);
-  void vCOMM_Send128BitDataMessage(union SP_128BitDataMessage * p_DataRetMessage);
-  void vCOMM_SendLabelMessage(union SP_LabelMessage * p_LabelMessage);
-  //! @}
-
-  //! @name Receive Functions
-  //! These functions take information from the \ref comm Module and format
-  //! it appropriately.
-  //! @{
-  uint8 ucCOMM_Grab32BitDataMessageFromBuffer(union SP_32BitDataMessage * message);
-  uint8 ucCOMM_Grab128BitDataMessageFromBuffer(union SP_128BitDataMessage * message);
-  uint8 ucCOMM_GrabLabelMessageFromBuffer(union SP_LabelMessage * message);
-  //! @}
-
-  //! @name Interrupt Handlers
-  //! These are the interrupt handlers used by the \ref comm Module.
-  //! @{
-  __interrupt void PORT2_ISR(void);
-  __interrupt void TIMERA0_ISR(void);
-  //! @}
-
-
-#endif /*COMM_H_*/
-//! @}
-//! @}
+///////////////////////////////////////////////////////////////////////////////
+//! \file comm.h
+//! \brief Header file for the software UART module
+//!
+//! This file provides all of the defines and function prototypes for the
+//! \ref comm Module.
+//!
+//! @addtogroup core
+//! @{
+//!
+//! @addtogroup comm Software UART
+//! The software UART module runs the CP link on the TimerA TA0 pins. RX bits
+//! are latched by the capture/compare unit. TX runs on TACCR1 in full-duplex,
+//! or on TACCR0 through the Out0 output unit in half-duplex. With framing,
+//! TACCR2 times out partial frames. The module requires the use of TimerA.
+//! @{
+///////////////////////////////////////////////////////////////////////////////
+//*****************************************************************************
+// By: Kenji Yamamoto
+//     Wireless Networks Research Lab
+//     Dept. of Electrical Engineering, CEFNS
+//     Northern Arizona University
+//
+//*****************************************************************************
+
+#ifndef COMM_H_
+  #define COMM_H_
+
+  //! \def RX_BUFFER_SIZE
+  //! \brief The number of bytes to allocate for each UART RX message buffer
+  #define RX_BUFFER_SIZE 0x20
+
+  //! \def COMM_RX_MESSAGES
+  //! \brief The number of UART RX message buffers
+  //!
+  //! The RX ISR fills one while the core works on the other. The code
+  //! toggles between the two, so this can not be changed.
+  #define COMM_RX_MESSAGES 2
+
+  //! \def TX_BUFFER_SIZE
+  //! \brief The number of bytes to allocate for the UART TX ring buffer
+  //!
+  //! Must be a power of two, the ring indices wrap with \ref TX_BUFFER_MASK.
+  #define TX_BUFFER_SIZE 0x20
+  //! \def TX_BUFFER_MASK
+  //! \brief Wraps an index into the UART TX ring buffer
+  #define TX_BUFFER_MASK (TX_BUFFER_SIZE - 1)
+
+  //! \def COMM_ADDRESS
+  //! \brief The address of this SP Board on the CP link, see SP_COMM_ADDRESSED
+  #define COMM_ADDRESS (((uint16)ID_PKT_HI_BYTE1 << 8) | ID_PKT_LO_BYTE1)
+
+  //! \def COMM_FRAME_MAX_PAYLOAD
+  //! \brief The longest message that fits in a frame in the message buffer
+  #define COMM_FRAME_MAX_PAYLOAD (RX_BUFFER_SIZE - SP_FRAME_OVERHEAD)
+
+  //! \def COMM_RX_TIMEOUT_BYTES
+  //! \brief Byte times of silence that end a partial frame
+  #define COMM_RX_TIMEOUT_BYTES 3
+
+  //! \def COMM_BAUD_VERIFY_OVERFLOWS
+  //! \brief How long to wait for each frame that confirms a BAUD_CHANGE
+  //!
+  //! Counted in TimerA overflows, 16.4 ms each with a 4 MHz SMCLK, so this
+  //! is about 262 ms at either SMCLK.
+  #define COMM_BAUD_VERIFY_OVERFLOWS (16 * (uint8)(CORE_SMCLK_HZ / 4000000))
+
+  //! \def COMM_DCO_WAKE_TICKS
+  //! \brief The time the DCO takes to start after LPM3 or LPM4, in timer ticks
+  //!
+  //! TimerA does not count while the DCO starts, so this part of the wake
+  //! latency cannot be measured. It is taken as 1 us from the datasheet.
+  #define COMM_DCO_WAKE_TICKS (uint16)(CORE_SMCLK_HZ / 1000000)
+  //! \def COMM_MIN_START_TICKS
+  //! \brief The shortest start delay the port interrupt can schedule on CCR0
+  //!
+  //! Any shorter and TAR could be past TACCR0 by the time it is written.
+  #define COMM_MIN_START_TICKS (uint16)(2 * (CORE_SMCLK_HZ / 1000000))
+
+  // Status Flags
+  //! \name Status Flags
+  //! These are bit defines that are used to set and clear the
+  //! g_ucCOMM_Flags register.
+  //! @{
+  //! \def COMM_RUNNING
+  //! \brief Bit define - Indicates UART is running
+  #define COMM_RUNNING 0x01
+  //! \def COMM_TX_BUSY
+  //! \brief Bit define - Indicates TX in progress
+  #define COMM_TX_BUSY 0x02
+  //! \def COMM_RX_BUSY
+  //! \brief Bit define - Indicates RX in progress
+  #define COMM_RX_BUSY 0x04
+  //! \def COMM_WAKE_CAL
+  //! \brief Bit define - Indicates the port interrupt is being timed
+  #define COMM_WAKE_CAL 0x08
+  //! \def COMM_AUTOBAUD
+  //! \brief Bit define - Indicates the next byte is timed for the baud rate
+  #define COMM_AUTOBAUD 0x10
+  //! \def COMM_BAUD_UNCONFIRMED
+  //! \brief Bit define - Indicates no good frame has come in at the measured
+  //! baud rate yet
+  #define COMM_BAUD_UNCONFIRMED 0x20
+  //! \def COMM_TIMED_OUT
+  //! \brief Bit define - Indicates a timed wait for a message ran out
+  #define COMM_TIMED_OUT 0x40
+  //! \def COMM_BROADCAST
+  //! \brief Bit define - Indicates the request being handled was broadcast,
+  //! so nothing is sent
+  #define COMM_BROADCAST 0x80
+
+  //! @}
+
+  // Baud rate defines
+  //! @name Baud Rate Defines
+  //! These are the baud rates the \ref comm Module supports, in units of
+  //! 100 bit/s, the same units the CP Board uses in a BAUD_CHANGE. The bit
+  //! period in timer ticks is worked out from \ref CORE_SMCLK_HZ with 8
+  //! fractional bits, so none of these rates pick up a rounding error.
+  //! @{
+  //! \def BAUD_460800
+  //! \brief Baud rate code for 460800 bit/s
+  #define BAUD_460800 4608
+  //! \def BAUD_345600
+  //! \brief Baud rate code for 345600 bit/s
+  #define BAUD_345600 3456
+  //! \def BAUD_230400
+  //! \brief Baud rate code for 230400 bit/s
+  #define BAUD_230400 2304
+  //! \def BAUD_115200
+  //! \brief Baud rate code for 115200 bit/s
+  #define BAUD_115200 1152
+  //! \def BAUD_57600
+  //! \brief Baud rate code for 57600 bit/s
+  #define BAUD_57600  576
+  //! \def BAUD_19200
+  //! \brief Baud rate code for 19200 bit/s
+  #define BAUD_19200  192
+  //! \def BAUD_9600
+  //! \brief Baud rate code for 9600 bit/s
+  #define BAUD_9600   96
+  //! \def BAUD_1200
+  //! \brief Baud rate code for 1200 bit/s
+  #define BAUD_1200   12
+  //! @}
+
+
+  // Return codes
+  //! \name Return Codes
+  //! Possible return codes from the \ref comm functions
+  //! @{
+  //! \def COMM_BUFFER_UNDERFLOW
+  //! \brief Function return code
+  //!
+  //! Getting this return code means that the user has tried to pull more
+  //! data that is avalibe from the RX message buffers
+  #define COMM_BUFFER_UNDERFLOW 0x01
+  //! \def COMM_FRAME_ERROR
+  //! \brief Function return code
+  //!
+  //! Getting this return code means that the received frame has the
+  //! wrong length or a bad CRC
+  #define COMM_FRAME_ERROR      0x02
+  //! \def COMM_TIMEOUT
+  //! \brief Function return code
+  //!
+  //! Getting this return code means that no message came in before the
+  //! timeout ran out
+  #define COMM_TIMEOUT          0x03
+  //! \def COMM_OK
+  //! \brief Function return code
+  #define COMM_OK               0x00
+  //! @}
+
+
+  // Comm.c function prototypes
+  //! @name Control Functions
+  //! These functions handle controlling the \ref comm Module.
+  //! @{
+  void vCOMM_Init(uint16 ucBaud);
+  void vCOMM_Shutdown(void);
+  void vCOMM_StartAutoBaud(void);
+  void vCOMM_SetBaud(uint16 unBaud);
+  uint16 unCOMM_GetBaud(void);
+  uint16 unCOMM_BaudForRate(uint16 unRate);
+  void vCOMM_WaitFor32BitDataMessage(void);
+  void vCOMM_WaitFor128BitDataMessage(void);
+  void vCOMM_WaitForLabelMessage(void);
+  uint8 ucCOMM_WaitFor32BitDataMessageTimeout(uint8 ucOverflows);
+  //! @}
+
+  //! @name Transmit Functions
+  //! These functions transmit information on the \ref comm Module.
+  //! @{
+  void vCOMM_SendByte(uint8 ucChar);
+  void vCOMM_WaitForTXComplete(void);
+  void vCOMM_Send32BitDataMessage(union SP_32BitDataMessage * p_DataMessage);
+  void vCOMM_SendNoChange(uint8 ucSensorNumber);
+  void vCOMM_Send128BitDataMessage(union SP_128BitDataMessage * p_DataRetMessage);
+  void vCOMM_SendVarDataMessage(union SP_VarDataMessage * p_VarDataMessage);
+  void vCOMM_SendBatchReport(union SP_BatchReportMessage * p_BatchReport);
+  void vCOMM_SendLabelMessage(union SP_LabelMessage * p_LabelMessage);
+  void vCOMM_ResendLastMessage(void);
+  //! @}
+
+  //! @name Receive Functions
+  //! These functions take information from the \ref comm Module and format
+  //! it appropriately.
+  //! @{
+  uint8 ucCOMM_Grab32BitDataMessageFromBuffer(union SP_32BitDataMessage * message);
+  uint8 ucCOMM_Grab128BitDataMessageFromBuffer(union SP_128BitDataMessage * message);
+  uint8 ucCOMM_GrabLabelMessageFromBuffer(union SP_LabelMessage * message);
+  union SP_32BitDataMessage * p_COMM_Take32BitDataMessage(void);
+  void vCOMM_ReleaseMessage(void);
+  uint8 ucCOMM_IsRepeatedRequest(void);
+  void vCOMM_ForgetRequest(void);
+  void vCOMM_FlushRX(void);
+  uint8 ucCOMM_RXPending(void);
+  uint8 ucCOMM_IsRunning(void);
+  void vCOMM_SendLinkStatus(uint8 ucClear);
+  void vCOMM_ClearLinkStatus(void);
+  uint16 unCOMM_CRC16Update(uint16 unCRC, uint8 ucData);
+  //! @}
+
+  //! @name Interrupt Handlers
+  //! These are the interrupt handlers used by the \ref comm Module.
+  //! @{
+  __interrupt void PORT2_ISR(void);
+  __interrupt void TIMERA0_ISR(void);
+  __interrupt void TIMERA1_ISR(void);
+  //! @}
+
+
+#endif /*COMM_H_*/
+//! @}
+//! @}
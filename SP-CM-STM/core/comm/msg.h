@@ -1,307 +1,789 @@
-///////////////////////////////////////////////////////////////////////////////
-//! \file msg.h
-//! \brief The file contains the Messages module
-//!
-//! @addtogroup core
-//! @{
-//!
-//! @addtogroup msg Messages
-//! The Messages Module (msg.h) contains all of the data structures and defines
-//! to communicate back and forth between the SP Board boards and the brain
-//! board
-//! @{
-///////////////////////////////////////////////////////////////////////////////
-//*****************************************************************************
-// By: Kenji Yamamoto
-//     Wireless Networks Research Lab
-//     Dept Of Electrical Engineering, CEFNS
-//     Northern Arizona University
-//
-//*****************************************************************************
-
-#ifndef MSG_H_
-  #define MSG_H_
-  //****************  SP Board Data Messages  *********************************//
-  //! @defgroup msg_data SP Board Data Message
-  //! The SP Board Data Message is used to sent data back and forth between the
-  //! SP Board and the CP Board. The request message is ALWAYS a data message, the
-  //! return message can be a data message or a label message.
-  //! @{
-  #define SP_DATAMESSAGE_VERSION 110     //!< Version 1.10
-
-  // Message Types
-  //! @name Data Message Types
-  //! These are the possible data message types.
-  //! @{
-  //! \def HAND_SHK (Test Packet)
-  //! \brief This is used to confirm that CP and SP communicate both ways.
-  //!
-  //! This packet is sent when the SP Board board sent the ID_PKT and the brain
-  //! wants to make sure communication is both ways.
-  #define HAND_SHK        0x00
-
-
-  //! \def ID_PKT
-  //! \brief This packet identifies the SP Board board to the CP Board
-  //!
-  //! This packet is only ever sent when the SP Board starts up and should
-  //! never be sent by the CP Board.
-  #define ID_PKT          0x01
-
-
-  //! \def REQUEST_DATA
-  //! \brief This packet requests data from the SP Board board
-  //!
-  //! This packet is only sent from the CP Board to the SP Board.
-  //! The SP will send a REPORT_DATA packet as a reply, either 32 bit or 128 bit
-  //! packet depending on the SP function.
-  #define REQUEST_DATA    0x02
-
-
-  //! \def REPORT_DATA
-  //! \brief This packet reports a transducer measurement to the CP Board
-  //!
-  //! This packet is only sent from the SP Board board to the CP Board. The
-  //! transducer measurement is contained in data1 through data 8.
-  //! The SP sends a 128 (1-8) bit or 32 (1-2) bit data packet, depending on the SP function
-  #define REPORT_DATA     0x03
-
-
-  //! \def REQUEST_LABEL
-  //! \brief This packet asks the SP Board board to send a label message back
-  //!
-  //! The packet is sent from the CP Board to the SP Board and the CP Board will
-  //! expect a SP_LabelMessage in return. At this time the data1 and
-  //! data2 fields in the message contain do-not-care values.
-  #define REQUEST_LABEL   0x04
-
-  //! \def COMMAND_PKT
-  //! \brief This packet contains the command from the CP Board to the SP Board on
-  //! what functions to execute.
-  //!
-  //! The SP Board replies with a CONFIRM_COMMAND if the command is valid
-  //!
-  #define COMMAND_PKT   0x05
-
-  //! \def CONFIRM_COMMAND
-  //! \brief This packet is used by the SP Board to confirm that the COMMAND_PKT
-  //! sent by the CP Board is valid and that the commands will be executed.
-  //!
-  #define CONFIRM_COMMAND   0x06
-
-  //! \def REPORT_ERROR
-  //! \brief This packet is used by the SP Board to report an error to the CP.
-  //!
-  //! The SP sends a 32/128 bit packet to the CP to report an error. An error is
-  //! if ANY one thing in the transducer function didn't work.
-  //!
-  #define REPORT_ERROR   0x07
-  //! @}
-
-  // Sensor Numbers
-  //! @name Data Message Sensor Numbers
-  //! These are the possible sensor numbers
-  //! @{
-  #define TRANSDUCER_0    0x00
-  #define TRANSDUCER_1    0x01
-  #define TRANSDUCER_2    0x02
-  #define TRANSDUCER_3    0x03
-  #define TRANSDUCER_4    0x04
-  #define TRANSDUCER_5    0x05
-  #define TRANSDUCER_6    0x06
-  #define TRANSDUCER_7    0x07
-  #define TRANSDUCER_8    0x08
-  #define TRANSDUCER_9    0x09
-  #define TRANSDUCER_A    0x0A
-  #define TRANSDUCER_B    0x0B
-  #define TRANSDUCER_C    0x0C
-  #define TRANSDUCER_D    0x0D
-  #define TRANSDUCER_E    0x0E
-  #define TRANSDUCER_F    0x0F
-  //! \def SP_CORE_VERSION
-  //! \brief This sensor number is for requesting the version string
-  //!
-  //! This sensor number should only EVER be used with REQUEST_LABEL packet.
-  //! Otherwise the system will try to access an array index that does
-  //! not exist, which will fault the hardware and lock up the software.
-  #define SP_CORE_VERSION 0x10
-  //! \def WRAPPER_VERSION
-  //! \brief This sensor number is for requesting the wrapper version string
-  //!
-  //! This sensor number should only EVER be used with REQEUST_LABEL packet.
-  //! Otherwise the system will try to access an array index that does not
-  //! exist, which will fault the hardware and lock up the software.
-  #define WRAPPER_VERSION 0x11
-  //! @}
-
-  //! \brief Structure of a SP Data Message
-  //!
-  //! This structure is only used to define the fields in SP_32BitDataMessage.
-  struct SP_32BitDataMessage_Fields
-  {
-    uint8 ucMsgVersion;       //!< The version number of the message protocol
-    uint8 ucMsgSize;          //!< Size of the message
-    uint8 ucMsgType;          //!< Type of the message.
-    uint8 ucSensorNumber;     //!< Sensor number.
-    uint8 ucData1_HI_BYTE;    //!< High byte of the first data field
-    uint8 ucData1_LO_BYTE;    //!< Low byte of the first data field
-    uint8 ucData2_HI_BYTE;    //!< High byte of the second data field
-    uint8 ucData2_LO_BYTE;    //!< Low byte of the second data field
-  };
-
-
-
-  //! \brief Structure of a SP Data Message -scb
-   //!
-   //! Needed 128 bits of data to be sent
-   //! This structure is only used to define the fields in SP_128BitDataMessage.
-  struct SP_128BitDataMessage_Fields
-  {
-    uint8 ucMsgVersion;       //!< The version number of the message protocol
-    uint8 ucMsgSize;          //!< Size of the message
-    uint8 ucMsgType;          //!< Type of the message.
-    uint8 ucSensorNumber;     //!< Sensor number.
-    uint8 ucData1_HI_BYTE;    //!< High byte of the 1st data field
-    uint8 ucData1_LO_BYTE;    //!< Low byte of the 1st data field
-    uint8 ucData2_HI_BYTE;    //!< High byte of the 2nd data field
-    uint8 ucData2_LO_BYTE;    //!< Low byte of the 2nd data field
-    uint8 ucData3_HI_BYTE;    //!< High byte of the 3rd data field
-    uint8 ucData3_LO_BYTE;    //!< Low byte of the 3rd data field
-    uint8 ucData4_HI_BYTE;    //!< High byte of the 4th data field
-    uint8 ucData4_LO_BYTE;    //!< Low byte of the 4th data field
-    uint8 ucData5_HI_BYTE;    //!< High byte of the 5th data field
-    uint8 ucData5_LO_BYTE;    //!< Low byte of the 5th data field
-    uint8 ucData6_HI_BYTE;    //!< High byte of the 6th data field
-    uint8 ucData6_LO_BYTE;    //!< Low byte of the 6th data field
-    uint8 ucData7_HI_BYTE;    //!< High byte of the 7th data field
-    uint8 ucData7_LO_BYTE;    //!< Low byte of the 7th data field
-    uint8 ucData8_HI_BYTE;    //!< High byte of the 8th data field
-    uint8 ucData8_LO_BYTE;    //!< Low byte of the 8th data field
-  };
-
-
-  //! @name Core Data Array
-  //! This array is where the information passed between the transducer function
-  //! and the core stored.
-  //! @var g_unaCoreData
-
-  //uint16 g_unaCoreData[8];
-
-  //! \def SP_32BITDATAMESSAGE_SIZE
-  //! \brief The size of a data message (in bytes).
-  #define SP_32BITDATAMESSAGE_SIZE sizeof(struct SP_32BitDataMessage_Fields)
-
-
-  //! \def SP_128BITDATAMESSAGE_SIZE -scb
-  //! \brief The size of a data return message (in bytes).
-  #define SP_128BITDATAMESSAGE_SIZE sizeof(struct SP_128BitDataMessage_Fields)
-
-
-  //! \brief This is the union used to work with data messages
-  //!
-  //! This union allows us to work with the variuos fields in the data message
-  //! easily while also making it easy send and receive using byte oriented
-  //! communication methods
-  union SP_32BitDataMessage
-  {
-    uint8 ucByteStream[SP_32BITDATAMESSAGE_SIZE];
-    struct SP_32BitDataMessage_Fields fields;
-  };
-  //! @}
-
-
-  //! \brief This is the union used to work with data return messages -scb
-  //!
-  //! This union allows us to work with the various fields in the data return message
-  //! easily while also making it easy send and receive using byte oriented
-  //! communication methods
-  union SP_128BitDataMessage
-  {
-    uint8 ucByteStream[SP_128BITDATAMESSAGE_SIZE];
-    struct SP_128BitDataMessage_Fields fields;
-  };
-  //! @}
-
-
-  //****************  SP Board Label Message  *********************************//
-  //! @defgroup msg_label SP Board Label Message
-  //! The SP Board Label Message is used to send labels (byte strings) to the
-  //! CP board. The label message is only ever sent in reponse to a
-  //! LABEL_REQUEST Data Message. (See \ref msg_data).
-  //! @{
-  #define SP_LABELMESSAGE_VERSION 102        //!< v1.02
-
-  // Message Types
-  //! \name Label Message Types
-  //! These are the possible Label Message types
-  //! @{
-  //! \def REPORT_LABEL
-  //! \brief This packet contains a label indicated by the sensor number.
-  //!
-  //! This type of label packet is only sent by the SP Board board in response
-  //! to a LABEL_REQUEST Data Message. It has a different packet length and
-  //! is longer than a Data Message and therefore can be receieved as a
-  //! Data Message in error.
-  #define REPORT_LABEL             0x01
-  //! @}
-
-  // Sensor Types
-  //! \name Label Message Sensor Numbers
-  //! These are the possible sensor numbers for Label Messages. While these
-  //! do overlap with the sensor numbers in \ref msg_data it is important
-  //! to use the right sensor number with the right packet incase one of the
-  //! message types changes.
-  //! @{
-  #define TRANSDUCER_0_LABEL       0x00
-  #define TRANSDUCER_1_LABEL       0x01
-  #define TRANSDUCER_2_LABEL       0x02
-  #define TRANSDUCER_3_LABEL       0x03
-  #define TRANSDUCER_4_LABEL       0x04
-  #define TRANSDUCER_5_LABEL       0x05
-  #define TRANSDUCER_6_LABEL       0x06
-  #define TRANSDUCER_7_LABEL       0x07
-  #define TRANSDUCER_8_LABEL       0x08
-  #define TRANSDUCER_9_LABEL       0x09
-  #define TRANSDUCER_A_LABEL       0x0A
-  #define TRANSDUCER_B_LABEL       0x0B
-  #define TRANSDUCER_C_LABEL       0x0C
-  #define TRANSDUCER_D_LABEL       0x0D
-  #define TRANSDUCER_E_LABEL       0x0E
-  #define TRANSDUCER_F_LABEL       0x0F
-  #define SP_CORE_VERSION_LABEL    0x10
-  #define WRAPPER_VERSION_LABEL    0x11
-  //! @}
-
-  //! \brief Structure of a SP Board Label Message
-  //!
-  //! This structure is only used inside of the SP_LabelMessage. It
-  //! should never be allocated on it's own.
-  struct SP_LabelMessage_Fields
-  {
-    uint8 ucMsgVersion;            //!< The version of the message protocol
-    uint8 ucMsgSize;               //!< Size of the message
-    uint8 ucMsgType;               //!< Type of Label Message
-    uint8 ucSensorNumber;          //!< Sensor Number
-    uint8 ucaDescription[TRANSDUCER_LABEL_LEN];//!< 16-byte char array for the label
-  };
-
-  //! \def SP_LABELMESSAGE_SIZE
-  //! \brief The size of the SP Board Label Message (in bytes).
-  #define SP_LABELMESSAGE_SIZE sizeof(struct SP_LabelMessage_Fields)
-
-  //! \brief The union used to work with label messages
-  //!
-  //! This union is what should be allocated to work with label messages. It
-  //! allows easy access into the variuos fields of the message and makes it
-  //! easy to send and receive using byte oriented communication methods.
-  union SP_LabelMessage
-  {
-    uint8 ucByteStream[SP_LABELMESSAGE_SIZE];
-    struct SP_LabelMessage_Fields fields;
-  };
-  //! @}
-
-#endif /*MSG_H_*/
-//! @}
-//! @}
-
+///////////////////////////////////////////////////////////////////////////////
+//! \file msg.h
+//! \brief The file contains the Messages module
+//!
+//! @addtogroup core
+//! @{
+//!
+//! @addtogroup msg Messages
+//! The Messages Module (msg.h) contains all of the data structures and defines
+//! to communicate back and forth between the SP Board boards and the brain
+//! board
+//! @{
+///////////////////////////////////////////////////////////////////////////////
+//*****************************************************************************
+// By: Kenji Yamamoto
+//     Wireless Networks Research Lab
+//     Dept Of Electrical Engineering, CEFNS
+//     Northern Arizona University
+//
+//*****************************************************************************
+
+#ifndef MSG_H_
+  #define MSG_H_
+  //****************  SP Board Frame  ****************************************//
+  //! @defgroup msg_frame SP Board Frame
+  //! With SP_COMM_FRAMED set, every message on the CP link is sent in a
+  //! frame so that a dropped or extra byte only costs the frame it hit:
+  //!
+  //! | SYNC | LEN | SEQ | message (LEN bytes) | CRC HI | CRC LO |
+  //!
+  //! With SP_COMM_ADDRESSED set the header carries an address as well:
+  //!
+  //! | SYNC | LEN | SEQ | ADDR HI | ADDR LO | message | CRC HI | CRC LO |
+  //!
+  //! The CRC is the CRC-16 CCITT (polynomial 0x1021, initial value 0xFFFF)
+  //! of the header after SYNC and the message bytes. A receiver hunts for SYNC, drops
+  //! frames that are too long, have a bad CRC or stop for longer than the
+  //! inter-byte timeout, and answers a corrupt frame with a NAK_PKT.
+  //!
+  //! SEQ is the sequence number of a request. The CP Board counts it from 1
+  //! to 255 for each new request and sends it unchanged when it repeats a
+  //! request whose reply it did not get. The SP Board answers a request with
+  //! the same SEQ as the one before it with its last reply again, without
+  //! running anything, and sends every reply with the SEQ of the request.
+  //! SEQ 0 turns this off, such a request is always handled. Messages the SP
+  //! Board sends on its own, such as a NAK_PKT, carry SEQ 0.
+  //!
+  //! ADDR is the address of the SP Board a request is for, and the address
+  //! of the SP Board that sent a reply. An SP Board only handles requests for
+  //! its own address or SP_ADDRESS_BROADCAST, and never answers the latter.
+  //! @{
+  //! \def SP_FRAME_SYNC
+  //! \brief The first byte of every frame
+  #define SP_FRAME_SYNC          0x7E
+  //! \def SP_FRAME_SEQ_NONE
+  //! \brief The SEQ of a message that is not part of the sequence
+  #define SP_FRAME_SEQ_NONE      0x00
+  //! \def SP_ADDRESS_BROADCAST
+  //! \brief The ADDR of a request for every SP Board on the line
+  #define SP_ADDRESS_BROADCAST   0xFFFF
+  //! \def SP_FRAME_HEADER_SIZE
+  //! \brief The number of bytes in front of the message (SYNC, LEN, SEQ and
+  //! with SP_COMM_ADDRESSED, ADDR)
+  #define SP_FRAME_HEADER_SIZE   (SP_COMM_ADDRESSED ? 5 : 3)
+  //! \def SP_FRAME_CRC_SIZE
+  //! \brief The number of CRC bytes behind the message
+  #define SP_FRAME_CRC_SIZE      2
+  //! \def SP_FRAME_OVERHEAD
+  //! \brief The number of bytes a frame adds to a message
+  #define SP_FRAME_OVERHEAD      (SP_FRAME_HEADER_SIZE + SP_FRAME_CRC_SIZE)
+  //! @}
+
+  //****************  SP Board Wake-up  **************************************//
+  //! \def SP_WAKE_BYTE
+  //! \brief The byte the CP Board sends ahead of a request to an SP Board
+  //! idling in LPM4
+  //!
+  //! The SP Board wakes on the start bit of this byte and needs a few us to get
+  //! the DCO running again, so the byte itself may be lost. Its only falling
+  //! edge is the start bit, so whatever part of it is sampled reads as 0xFF
+  //! or a glitch, and it is thrown away either way.
+  #define SP_WAKE_BYTE           0xFF
+
+  //****************  SP Board Data Messages  *********************************//
+  //! @defgroup msg_data SP Board Data Message
+  //! The SP Board Data Message is used to sent data back and forth between the
+  //! SP Board and the CP Board. The request message is ALWAYS a data message, the
+  //! return message can be a data message or a label message.
+  //! @{
+  #define SP_DATAMESSAGE_VERSION 110     //!< Version 1.10
+
+  // Message Types
+  //! @name Data Message Types
+  //! These are the possible data message types.
+  //! @{
+  //! \def HAND_SHK (Test Packet)
+  //! \brief This is used to confirm that CP and SP communicate both ways.
+  //!
+  //! This packet is sent when the SP Board board sent the ID_PKT and the brain
+  //! wants to make sure communication is both ways.
+  #define HAND_SHK        0x00
+
+
+  //! \def ID_PKT
+  //! \brief This packet identifies the SP Board board to the CP Board
+  //!
+  //! This packet is only ever sent when the SP Board starts up and should
+  //! never be sent by the CP Board.
+  #define ID_PKT          0x01
+
+
+  //! \def REQUEST_DATA
+  //! \brief This packet requests data from the SP Board board
+  //!
+  //! This packet is only sent from the CP Board to the SP Board.
+  //! The SP will send a REPORT_DATA packet as a reply, either 32 bit or 128 bit
+  //! packet depending on the SP function, or a REPORT_VAR_DATA if the SP
+  //! Board is built with SP_PACKET_VARIABLE.
+  #define REQUEST_DATA    0x02
+
+
+  //! \def REPORT_DATA
+  //! \brief This packet reports a transducer measurement to the CP Board
+  //!
+  //! This packet is only sent from the SP Board board to the CP Board. The
+  //! transducer measurement is contained in data1 through data 8.
+  //! The SP sends a 128 (1-8) bit or 32 (1-2) bit data packet, depending on the SP function
+  #define REPORT_DATA     0x03
+
+
+  //! \def REQUEST_LABEL
+  //! \brief This packet asks the SP Board board to send a label message back
+  //!
+  //! The packet is sent from the CP Board to the SP Board and the CP Board will
+  //! expect a SP_LabelMessage in return. At this time the data1 and
+  //! data2 fields in the message contain do-not-care values.
+  #define REQUEST_LABEL   0x04
+
+  //! \def COMMAND_PKT
+  //! \brief This packet contains the command from the CP Board to the SP Board on
+  //! what functions to execute.
+  //!
+  //! The SP Board replies with a CONFIRM_COMMAND if the command is valid
+  //!
+  #define COMMAND_PKT   0x05
+
+  //! \def CONFIRM_COMMAND
+  //! \brief This packet is used by the SP Board to confirm that the COMMAND_PKT
+  //! sent by the CP Board is valid and that the commands will be executed.
+  //!
+  #define CONFIRM_COMMAND   0x06
+
+  //! \def REPORT_ERROR
+  //! \brief This packet is used by the SP Board to report an error to the CP.
+  //!
+  //! The SP sends a 32/128 bit packet to the CP to report an error. An error is
+  //! if ANY one thing in the transducer function didn't work.
+  //!
+  #define REPORT_ERROR   0x07
+
+  //! \def NAK_PKT
+  //! \brief This packet asks the other side to send its last message again.
+  //!
+  //! Either board sends a NAK_PKT when a frame arrives with a bad length or
+  //! CRC (see \ref msg_frame). The other side answers by sending its last
+  //! message again, unchanged. The data fields are do-not-care values.
+  //!
+  #define NAK_PKT   0x08
+
+  //! \def BAUD_CHANGE
+  //! \brief This packet moves the CP link to a new baud rate.
+  //!
+  //! The CP Board proposes the new rate in data1, in units of 100 bit/s
+  //! (1152 for 115200). The SP Board answers with a BAUD_CHANGE at the old
+  //! rate: data1 is the accepted rate, or 0 if the rate is not supported.
+  //! Once the answer is sent, both sides switch. The CP Board then sends a
+  //! HAND_SHK at the new rate, which the SP Board answers as usual. The new
+  //! rate is provisional until the CP Board sends its next request at it,
+  //! which it must do within the same time, a second HAND_SHK if it has
+  //! nothing else to send. That request is handled as usual and makes the
+  //! new rate stick. If the SP Board does not get the HAND_SHK or the next
+  //! request in time, or the CP Board does not get the answer to the
+  //! HAND_SHK, both sides go back to the old rate. Each wait is about 262 ms.
+  //!
+  #define BAUD_CHANGE   0x09
+
+  //! \def REQUEST_LINK_STATUS
+  //! \brief This packet asks the SP Board for its CP link statistics
+  //!
+  //! The SP Board answers with a REPORT_LINK_STATUS. If data1 is not 0 the
+  //! counters are cleared once they are reported, the drift is kept.
+  //!
+  #define REQUEST_LINK_STATUS   0x0A
+
+  //! \def REPORT_LINK_STATUS
+  //! \brief This packet reports the CP link statistics to the CP Board
+  //!
+  //! This is a 128 bit data message:
+  //! - data1 is the number of bytes lost because both RX message buffers
+  //!   were full
+  //! - data2 the number of frames dropped for a bad length, a bad CRC or an
+  //!   inter-byte timeout
+  //! - data3 the number of bytes dropped for a low stop bit
+  //! - data4 the number of bytes received and data5 the number sent
+  //! - data6 the number of frames dropped for a bad CRC, 0 without framing
+  //! - data7 how many timer ticks longer 10 bit periods of the CP Board are
+  //!   than 10 of ours, signed. It is measured on bytes sent back to back
+  //!   and is 0 until there have been any.
+  //! - data8 the most timer ticks the software UART ISRs have run behind
+  //!   their bit edge, 0 without SP_COMM_LATENCY_STATS
+  //!
+  //! The timer runs at the SMCLK, see SP_SMCLK_16MHZ. The counters wrap at
+  //! 0xFFFF.
+  //!
+  #define REPORT_LINK_STATUS   0x0B
+
+  //! \def REPORT_VAR_DATA
+  //! \brief This packet reports a transducer measurement with only the data
+  //! words that are not 0
+  //!
+  //! This is a variable length data message, sent by the SP Board instead of
+  //! REPORT_DATA when SP_PACKET_VARIABLE is set. See SP_VarDataMessage_Fields
+  //! for how the CP Board decodes it.
+  //!
+  #define REPORT_VAR_DATA   0x0C
+
+  //! \def REPORT_VAR_ERROR
+  //! \brief The variable length form of REPORT_ERROR
+  //!
+  //! Laid out and decoded as REPORT_VAR_DATA, the data words hold the error
+  //! codes written by the transducer function.
+  //!
+  #define REPORT_VAR_ERROR   0x0D
+
+  //! \def COMMAND_REPORT_PKT
+  //! \brief A COMMAND_PKT that is answered with the report in one transaction
+  //!
+  //! The fields are the same as for a COMMAND_PKT. The SP Board does not send
+  //! a CONFIRM_COMMAND, it runs the transducer function and sends the report
+  //! as soon as it returns, as if a REQUEST_DATA had come in. The CP Board
+  //! just waits for the report, however long the transducer takes.
+  //!
+  #define COMMAND_REPORT_PKT   0x0E
+
+  //! \def BATCH_PKT
+  //! \brief This packet runs several transducer functions in one go
+  //!
+  //! The CP Board lists up to SP_BATCH_MAX_ENTRIES transducer numbers, each
+  //! with the two data words a COMMAND_PKT would carry (see
+  //! SP_BatchMessage_Fields). The SP Board runs them in order and answers
+  //! with one REPORT_BATCH. No CONFIRM_COMMAND is sent. A REQUEST_DATA
+  //! afterwards reports the data of the last entry.
+  //!
+  #define BATCH_PKT   0x0F
+
+  //! \def REPORT_BATCH
+  //! \brief This packet reports how each entry of a BATCH_PKT went
+  //!
+  //! See SP_BatchReport_Fields. A BATCH_PKT with a size that does not match
+  //! its entry count is answered with a REPORT_BATCH with no entries.
+  //!
+  #define REPORT_BATCH   0x10
+
+  //! \def REQUEST_DESCRIPTOR
+  //! \brief This packet asks the SP Board to describe itself in one go
+  //!
+  //! It takes the place of a REQUEST_LABEL for every sensor number. The data
+  //! fields are do-not-care values. The SP Board answers with a
+  //! REPORT_DESCRIPTOR followed right away by SP_DESCRIPTOR_LABELS
+  //! REPORT_LABEL messages, for sensor numbers 0x00 to WRAPPER_VERSION in
+  //! order. If one of the labels comes in corrupt, the CP Board asks for it
+  //! again with a REQUEST_LABEL.
+  //!
+  #define REQUEST_DESCRIPTOR   0x11
+
+  //! \def REPORT_DESCRIPTOR
+  //! \brief This packet starts the answer to a REQUEST_DESCRIPTOR
+  //!
+  //! ucSensorNumber is the number of label messages that follow. data1 holds
+  //! the \ref SP_CAP_BATCH "capability flags". The high byte of data2 is
+  //! SP_BATCH_MAX_ENTRIES, the low byte the size of the largest data report
+  //! the SP Board sends.
+  //!
+  #define REPORT_DESCRIPTOR   0x12
+
+  //! \def TRIGGER_PKT
+  //! \brief A COMMAND_PKT that starts the measurement without any answer
+  //!
+  //! The fields are the same as for a COMMAND_PKT. The SP Board runs the
+  //! transducer function right away and keeps the result until the next
+  //! command, nothing is sent back. Sent to SP_ADDRESS_BROADCAST, every SP
+  //! Board on the line samples at the same time, and the CP Board then
+  //! collects the results one board at a time with a REQUEST_DATA. The CP
+  //! Board must leave the transducers time to finish before it does.
+  //!
+  #define TRIGGER_PKT   0x13
+
+  //! \def UPDATE_START_PKT
+  //! \brief This packet starts a firmware update
+  //!
+  //! Sent as a 128 bit data message. data1 is the number of 512 byte flash
+  //! segments in the image, from the start of the application area, data2
+  //! the CRC-16 of them and data3 the CRC-16 of the BOOT area the image was
+  //! linked against (see \ref msg_update). The SP Board answers with an
+  //! UPDATE_ACK and from then on only handles UPDATE packets, until the new
+  //! image is started. If data3 is not the CRC of its own BOOT area, it
+  //! answers with SP_UPDATE_WRONG_BOOT and goes back to the application.
+  //!
+  #define UPDATE_START_PKT   0x14
+
+  //! \def UPDATE_DATA_PKT
+  //! \brief This packet carries one chunk of a flash segment
+  //!
+  //! See SP_UpdateDataMessage_Fields. It is not answered, the CP Board sends
+  //! all of the chunks of a segment back to back with SEQ 0.
+  //!
+  #define UPDATE_DATA_PKT   0x15
+
+  //! \def UPDATE_WRITE_PKT
+  //! \brief This packet asks the SP Board to program the segment it collected
+  //!
+  //! ucSensorNumber is the segment number. The SP Board answers with an
+  //! UPDATE_ACK once the segment is erased, written and read back.
+  //!
+  #define UPDATE_WRITE_PKT   0x16
+
+  //! \def UPDATE_FINISH_PKT
+  //! \brief This packet ends a firmware update
+  //!
+  //! The SP Board checks that the CRC of the image matches the one sent with
+  //! the UPDATE_START_PKT. If so, it answers with an UPDATE_ACK and restarts
+  //! into the new image.
+  //!
+  #define UPDATE_FINISH_PKT   0x17
+
+  //! \def UPDATE_ACK
+  //! \brief This packet answers the UPDATE packets
+  //!
+  //! ucSensorNumber is the \ref SP_UPDATE_OK "update status". With
+  //! SP_UPDATE_MISSING, data1 (high word) and data2 (low word) have a bit set
+  //! for each chunk of the segment that has not come in. The answer to an
+  //! UPDATE_START_PKT has the number of application segments the SP Board
+  //! takes in data1 and the CRC of its BOOT area in data2.
+  //!
+  #define UPDATE_ACK   0x18
+
+  //! \def SET_DEADBAND_PKT
+  //! \brief This packet sets the report deadband of a transducer
+  //!
+  //! data1 is the deadband for ucSensorNumber, in the units of the data
+  //! words, 0 to always send the full report. The SP Board answers with a
+  //! CONFIRM_COMMAND, and the next report of the transducer is a full one.
+  //!
+  #define SET_DEADBAND_PKT   0x19
+
+  //! \def REPORT_NO_CHANGE
+  //! \brief This packet answers a REQUEST_DATA when nothing has moved
+  //!
+  //! Sent with SP_REPORT_BY_EXCEPTION instead of the report, when no data
+  //! word moved by more than the deadband of the transducer since the last
+  //! report that was sent. It is only the 4 byte header, ucSensorNumber is the
+  //! transducer.
+  //!
+  #define REPORT_NO_CHANGE   0x1A
+  //! @}
+
+  // Sensor Numbers
+  //! @name Data Message Sensor Numbers
+  //! These are the possible sensor numbers
+  //! @{
+  #define TRANSDUCER_0    0x00
+  #define TRANSDUCER_1    0x01
+  #define TRANSDUCER_2    0x02
+  #define TRANSDUCER_3    0x03
+  #define TRANSDUCER_4    0x04
+  #define TRANSDUCER_5    0x05
+  #define TRANSDUCER_6    0x06
+  #define TRANSDUCER_7    0x07
+  #define TRANSDUCER_8    0x08
+  #define TRANSDUCER_9    0x09
+  #define TRANSDUCER_A    0x0A
+  #define TRANSDUCER_B    0x0B
+  #define TRANSDUCER_C    0x0C
+  #define TRANSDUCER_D    0x0D
+  #define TRANSDUCER_E    0x0E
+  #define TRANSDUCER_F    0x0F
+  //! \def SP_CORE_VERSION
+  //! \brief This sensor number is for requesting the version string
+  //!
+  //! This sensor number should only EVER be used with REQUEST_LABEL packet.
+  //! Otherwise the system will try to access an array index that does
+  //! not exist, which will fault the hardware and lock up the software.
+  #define SP_CORE_VERSION 0x10
+  //! \def WRAPPER_VERSION
+  //! \brief This sensor number is for requesting the wrapper version string
+  //!
+  //! This sensor number should only EVER be used with REQEUST_LABEL packet.
+  //! Otherwise the system will try to access an array index that does not
+  //! exist, which will fault the hardware and lock up the software.
+  #define WRAPPER_VERSION 0x11
+  //! @}
+
+  //! \def SP_DESCRIPTOR_LABELS
+  //! \brief The number of label messages that follow a REPORT_DESCRIPTOR
+  #define SP_DESCRIPTOR_LABELS   (WRAPPER_VERSION + 1)
+
+  //! @name Capability Flags
+  //! These are the bits of data1 in a REPORT_DESCRIPTOR.
+  //! @{
+  #define SP_CAP_128BIT_DATA     0x0001  //!< REPORT_DATA is a 128 bit data message
+  #define SP_CAP_VAR_DATA        0x0002  //!< Data is reported with REPORT_VAR_DATA
+  #define SP_CAP_FRAMED          0x0004  //!< Messages are sent in frames
+  #define SP_CAP_BATCH           0x0008  //!< BATCH_PKT is handled
+  #define SP_CAP_COMMAND_REPORT  0x0010  //!< COMMAND_REPORT_PKT is handled
+  #define SP_CAP_PACKED_5TM      0x0020  //!< 5TM and valve results are packed records
+  #define SP_CAP_ADDRESSED       0x0040  //!< Frames carry an address
+  #define SP_CAP_TRIGGER         0x0080  //!< TRIGGER_PKT is handled
+  #define SP_CAP_UPDATE          0x0100  //!< Firmware can be updated over the link
+  #define SP_CAP_DEADBAND        0x0200  //!< SET_DEADBAND_PKT is handled
+  //! @}
+
+  //! \brief Structure of a SP Data Message
+  //!
+  //! This structure is only used to define the fields in SP_32BitDataMessage.
+  struct SP_32BitDataMessage_Fields
+  {
+    uint8 ucMsgVersion;       //!< The version number of the message protocol
+    uint8 ucMsgSize;          //!< Size of the message
+    uint8 ucMsgType;          //!< Type of the message.
+    uint8 ucSensorNumber;     //!< Sensor number.
+    uint8 ucData1_HI_BYTE;    //!< High byte of the first data field
+    uint8 ucData1_LO_BYTE;    //!< Low byte of the first data field
+    uint8 ucData2_HI_BYTE;    //!< High byte of the second data field
+    uint8 ucData2_LO_BYTE;    //!< Low byte of the second data field
+  };
+
+
+
+  //! \brief Structure of a SP Data Message -scb
+   //!
+   //! Needed 128 bits of data to be sent
+   //! This structure is only used to define the fields in SP_128BitDataMessage.
+  struct SP_128BitDataMessage_Fields
+  {
+    uint8 ucMsgVersion;       //!< The version number of the message protocol
+    uint8 ucMsgSize;          //!< Size of the message
+    uint8 ucMsgType;          //!< Type of the message.
+    uint8 ucSensorNumber;     //!< Sensor number.
+    uint8 ucData1_HI_BYTE;    //!< High byte of the 1st data field
+    uint8 ucData1_LO_BYTE;    //!< Low byte of the 1st data field
+    uint8 ucData2_HI_BYTE;    //!< High byte of the 2nd data field
+    uint8 ucData2_LO_BYTE;    //!< Low byte of the 2nd data field
+    uint8 ucData3_HI_BYTE;    //!< High byte of the 3rd data field
+    uint8 ucData3_LO_BYTE;    //!< Low byte of the 3rd data field
+    uint8 ucData4_HI_BYTE;    //!< High byte of the 4th data field
+    uint8 ucData4_LO_BYTE;    //!< Low byte of the 4th data field
+    uint8 ucData5_HI_BYTE;    //!< High byte of the 5th data field
+    uint8 ucData5_LO_BYTE;    //!< Low byte of the 5th data field
+    uint8 ucData6_HI_BYTE;    //!< High byte of the 6th data field
+    uint8 ucData6_LO_BYTE;    //!< Low byte of the 6th data field
+    uint8 ucData7_HI_BYTE;    //!< High byte of the 7th data field
+    uint8 ucData7_LO_BYTE;    //!< Low byte of the 7th data field
+    uint8 ucData8_HI_BYTE;    //!< High byte of the 8th data field
+    uint8 ucData8_LO_BYTE;    //!< Low byte of the 8th data field
+  };
+
+
+  //! @name Core Data Array
+  //! This array is where the information passed between the transducer function
+  //! and the core stored.
+  //! @var g_unaCoreData
+
+  //uint16 g_unaCoreData[8];
+
+  //! \def SP_32BITDATAMESSAGE_SIZE
+  //! \brief The size of a data message (in bytes).
+  #define SP_32BITDATAMESSAGE_SIZE sizeof(struct SP_32BitDataMessage_Fields)
+
+  //! \def SP_NOCHANGEMESSAGE_SIZE
+  //! \brief The size of a REPORT_NO_CHANGE, the data message header (in bytes).
+  #define SP_NOCHANGEMESSAGE_SIZE 4
+
+
+  //! \def SP_128BITDATAMESSAGE_SIZE -scb
+  //! \brief The size of a data return message (in bytes).
+  #define SP_128BITDATAMESSAGE_SIZE sizeof(struct SP_128BitDataMessage_Fields)
+
+
+  //! \brief This is the union used to work with data messages
+  //!
+  //! This union allows us to work with the variuos fields in the data message
+  //! easily while also making it easy send and receive using byte oriented
+  //! communication methods
+  union SP_32BitDataMessage
+  {
+    uint8 ucByteStream[SP_32BITDATAMESSAGE_SIZE];
+    struct SP_32BitDataMessage_Fields fields;
+  };
+  //! @}
+
+
+  //! \brief This is the union used to work with data return messages -scb
+  //!
+  //! This union allows us to work with the various fields in the data return message
+  //! easily while also making it easy send and receive using byte oriented
+  //! communication methods
+  union SP_128BitDataMessage
+  {
+    uint8 ucByteStream[SP_128BITDATAMESSAGE_SIZE];
+    struct SP_128BitDataMessage_Fields fields;
+  };
+  //! @}
+
+  //! \def SP_VARDATA_MAX_WORDS
+  //! \brief The number of data words a variable length data message can carry
+  #define SP_VARDATA_MAX_WORDS   8
+
+  //! \brief Structure of a variable length SP Data Message
+  //!
+  //! ucMsgSize is the number of bytes actually sent, the 5 header bytes and 2
+  //! bytes for each bit set in ucDataMask. Bit n of ucDataMask set means data
+  //! word n + 1 is in ucaData, high byte first. The words are in the order of
+  //! their bits, lowest first. The CP Board takes every data word whose bit
+  //! is clear as 0, so the SP Board leaves out all the words that are 0 and
+  //! the CP Board ends up with the same 8 words a REPORT_DATA would carry.
+  //!
+  //! This structure is only used to define the fields in SP_VarDataMessage.
+  struct SP_VarDataMessage_Fields
+  {
+    uint8 ucMsgVersion;       //!< The version number of the message protocol
+    uint8 ucMsgSize;          //!< Size of the message as sent
+    uint8 ucMsgType;          //!< Type of the message.
+    uint8 ucSensorNumber;     //!< Sensor number.
+    uint8 ucDataMask;         //!< Which data words follow, bit 0 for data1
+    uint8 ucaData[2 * SP_VARDATA_MAX_WORDS]; //!< The data words sent, HI byte first
+  };
+
+  //! \def SP_VARDATAMESSAGE_HEADER_SIZE
+  //! \brief The size of a variable length data message with no data words
+  #define SP_VARDATAMESSAGE_HEADER_SIZE 5
+
+  //! \def SP_VARDATAMESSAGE_MAX_SIZE
+  //! \brief The size of a variable length data message with all data words
+  #define SP_VARDATAMESSAGE_MAX_SIZE sizeof(struct SP_VarDataMessage_Fields)
+
+  //! \brief This is the union used to work with variable length data messages
+  //!
+  //! Only the first ucMsgSize bytes of ucByteStream are sent.
+  union SP_VarDataMessage
+  {
+    uint8 ucByteStream[SP_VARDATAMESSAGE_MAX_SIZE];
+    struct SP_VarDataMessage_Fields fields;
+  };
+
+
+  //! \def SP_BATCH_MAX_ENTRIES
+  //! \brief The number of entries a BATCH_PKT can carry
+  //!
+  //! This is as many as fit in a frame (see COMM_FRAME_MAX_PAYLOAD).
+  #define SP_BATCH_MAX_ENTRIES   4
+
+  //! @name Batch Entry Status
+  //! These are the possible ucStatus values in a REPORT_BATCH entry.
+  //! @{
+  #define SP_BATCH_FAILED        0x00   //!< The transducer function returned 0
+  #define SP_BATCH_OK            0x01   //!< The transducer function went ok
+  #define SP_BATCH_NO_TRANSDUCER 0xFF   //!< There is no function for the number
+  //! @}
+
+  //! \brief Structure of one entry of a BATCH_PKT
+  struct SP_BatchEntry
+  {
+    uint8 ucSensorNumber;     //!< Sensor number.
+    uint8 ucData1_HI_BYTE;    //!< High byte of the first data field
+    uint8 ucData1_LO_BYTE;    //!< Low byte of the first data field
+    uint8 ucData2_HI_BYTE;    //!< High byte of the second data field
+    uint8 ucData2_LO_BYTE;    //!< Low byte of the second data field
+  };
+
+  //! \def SP_BATCHENTRY_SIZE
+  //! \brief The size of one entry of a BATCH_PKT (in bytes).
+  #define SP_BATCHENTRY_SIZE sizeof(struct SP_BatchEntry)
+
+  //! \brief Structure of a BATCH_PKT
+  //!
+  //! ucMsgSize is 4 plus 5 bytes for each of the ucEntryCount entries that
+  //! are sent.
+  struct SP_BatchMessage_Fields
+  {
+    uint8 ucMsgVersion;       //!< The version number of the message protocol
+    uint8 ucMsgSize;          //!< Size of the message as sent
+    uint8 ucMsgType;          //!< Type of the message.
+    uint8 ucEntryCount;       //!< The number of entries that follow
+    struct SP_BatchEntry Entries[SP_BATCH_MAX_ENTRIES]; //!< The entries, run in order
+  };
+
+  //! \def SP_BATCHMESSAGE_HEADER_SIZE
+  //! \brief The size of a BATCH_PKT or REPORT_BATCH with no entries
+  #define SP_BATCHMESSAGE_HEADER_SIZE 4
+
+  //! \def SP_BATCHMESSAGE_MAX_SIZE
+  //! \brief The size of a BATCH_PKT with all entries
+  #define SP_BATCHMESSAGE_MAX_SIZE sizeof(struct SP_BatchMessage_Fields)
+
+  //! \brief This is the union used to work with BATCH_PKT messages
+  union SP_BatchMessage
+  {
+    uint8 ucByteStream[SP_BATCHMESSAGE_MAX_SIZE];
+    struct SP_BatchMessage_Fields fields;
+  };
+
+  //! \brief Structure of one entry of a REPORT_BATCH
+  struct SP_BatchResult
+  {
+    uint8 ucSensorNumber;     //!< Sensor number of the BATCH_PKT entry
+    uint8 ucStatus;           //!< How it went, see \ref SP_BATCH_OK
+  };
+
+  //! \brief Structure of a REPORT_BATCH
+  //!
+  //! ucMsgSize is 4 plus 2 bytes for each of the ucEntryCount results that
+  //! are sent. The results are in the order of the BATCH_PKT entries.
+  struct SP_BatchReport_Fields
+  {
+    uint8 ucMsgVersion;       //!< The version number of the message protocol
+    uint8 ucMsgSize;          //!< Size of the message as sent
+    uint8 ucMsgType;          //!< Type of the message.
+    uint8 ucEntryCount;       //!< The number of results that follow
+    struct SP_BatchResult Results[SP_BATCH_MAX_ENTRIES]; //!< One result per entry
+  };
+
+  //! \def SP_BATCHREPORT_MAX_SIZE
+  //! \brief The size of a REPORT_BATCH with all entries
+  #define SP_BATCHREPORT_MAX_SIZE sizeof(struct SP_BatchReport_Fields)
+
+  //! \brief This is the union used to work with REPORT_BATCH messages
+  union SP_BatchReportMessage
+  {
+    uint8 ucByteStream[SP_BATCHREPORT_MAX_SIZE];
+    struct SP_BatchReport_Fields fields;
+  };
+
+  //****************  SP Board Firmware Update  ******************************//
+  //! @defgroup msg_update SP Board Firmware Update
+  //! With SP_FIRMWARE_UPDATE set, the CP Board can send a new application
+  //! image over the link. The image is sent a 512 byte flash segment at a
+  //! time, starting at segment 0 (the start of the application area). Each
+  //! segment goes as SP_UPDATE_CHUNKS UPDATE_DATA_PKT messages followed by an
+  //! UPDATE_WRITE_PKT, and the next segment is only sent after its
+  //! UPDATE_ACK. No segment is written before an UPDATE_START_PKT has been
+  //! taken, also after a restart in the middle of an update. The interrupt
+  //! vectors of the application are in the application vector table at the
+  //! start of segment 0, so they are part of the image. The interrupt vector
+  //! segment belongs to the BOOT area and is never sent. The image CRC in the
+  //! UPDATE_START_PKT is the CRC-16 CCITT (initial value 0xFFFF) of the
+  //! application segments in order. The BOOT CRC is the same CRC of the
+  //! BOOT link image from 0xEE00 to the end of flash, with the unused flash
+  //! taken as 0xFF.
+  //! @{
+
+  //! \def SP_UPDATE_SEGMENT_SIZE
+  //! \brief The size of a main flash segment (in bytes)
+  #define SP_UPDATE_SEGMENT_SIZE   512
+
+  //! \def SP_UPDATE_CHUNK_SIZE
+  //! \brief The number of image bytes in an UPDATE_DATA_PKT
+  #define SP_UPDATE_CHUNK_SIZE     16
+
+  //! \def SP_UPDATE_CHUNKS
+  //! \brief The number of UPDATE_DATA_PKT messages per segment
+  #define SP_UPDATE_CHUNKS         (SP_UPDATE_SEGMENT_SIZE / SP_UPDATE_CHUNK_SIZE)
+
+  //! @name Update Status
+  //! These are the possible ucSensorNumber values in an UPDATE_ACK.
+  //! @{
+  #define SP_UPDATE_OK            0x00   //!< Done
+  #define SP_UPDATE_MISSING       0x01   //!< Chunks of the segment did not come in
+  #define SP_UPDATE_BAD_SEGMENT   0x02   //!< The segment may not be written
+  #define SP_UPDATE_FLASH_ERROR   0x03   //!< The segment did not read back right
+  #define SP_UPDATE_BAD_IMAGE     0x04   //!< The image size or CRC is wrong
+  #define SP_UPDATE_BUSY          0x05   //!< Only UPDATE packets are handled
+  #define SP_UPDATE_WRONG_BOOT    0x06   //!< The image is for another BOOT area
+  //! @}
+
+  //! \brief Structure of an UPDATE_DATA_PKT
+  struct SP_UpdateDataMessage_Fields
+  {
+    uint8 ucMsgVersion;       //!< The version number of the message protocol
+    uint8 ucMsgSize;          //!< Size of the message
+    uint8 ucMsgType;          //!< Type of the message.
+    uint8 ucChunk;            //!< Chunk number in the segment, 0 to SP_UPDATE_CHUNKS - 1
+    uint8 ucSegment;          //!< Segment number
+    uint8 ucaData[SP_UPDATE_CHUNK_SIZE]; //!< The image bytes
+  };
+
+  //! \def SP_UPDATEDATAMESSAGE_SIZE
+  //! \brief The size of an UPDATE_DATA_PKT (in bytes).
+  #define SP_UPDATEDATAMESSAGE_SIZE sizeof(struct SP_UpdateDataMessage_Fields)
+
+  //! \brief This is the union used to work with UPDATE_DATA_PKT messages
+  union SP_UpdateDataMessage
+  {
+    uint8 ucByteStream[SP_UPDATEDATAMESSAGE_SIZE];
+    struct SP_UpdateDataMessage_Fields fields;
+  };
+  //! @}
+
+  //****************  SP Board Label Message  *********************************//
+  //! @defgroup msg_label SP Board Label Message
+  //! The SP Board Label Message is used to send labels (byte strings) to the
+  //! CP board. The label message is only ever sent in reponse to a
+  //! LABEL_REQUEST Data Message. (See \ref msg_data).
+  //! @{
+  #define SP_LABELMESSAGE_VERSION 102        //!< v1.02
+
+  // Message Types
+  //! \name Label Message Types
+  //! These are the possible Label Message types
+  //! @{
+  //! \def REPORT_LABEL
+  //! \brief This packet contains a label indicated by the sensor number.
+  //!
+  //! This type of label packet is only sent by the SP Board board in response
+  //! to a LABEL_REQUEST Data Message. It has a different packet length and
+  //! is longer than a Data Message and therefore can be receieved as a
+  //! Data Message in error.
+  #define REPORT_LABEL             0x01
+  //! @}
+
+  // Sensor Types
+  //! \name Label Message Sensor Numbers
+  //! These are the possible sensor numbers for Label Messages. While these
+  //! do overlap with the sensor numbers in \ref msg_data it is important
+  //! to use the right sensor number with the right packet incase one of the
+  //! message types changes.
+  //! @{
+  #define TRANSDUCER_0_LABEL       0x00
+  #define TRANSDUCER_1_LABEL       0x01
+  #define TRANSDUCER_2_LABEL       0x02
+  #define TRANSDUCER_3_LABEL       0x03
+  #define TRANSDUCER_4_LABEL       0x04
+  #define TRANSDUCER_5_LABEL       0x05
+  #define TRANSDUCER_6_LABEL       0x06
+  #define TRANSDUCER_7_LABEL       0x07
+  #define TRANSDUCER_8_LABEL       0x08
+  #define TRANSDUCER_9_LABEL       0x09
+  #define TRANSDUCER_A_LABEL       0x0A
+  #define TRANSDUCER_B_LABEL       0x0B
+  #define TRANSDUCER_C_LABEL       0x0C
+  #define TRANSDUCER_D_LABEL       0x0D
+  #define TRANSDUCER_E_LABEL       0x0E
+  #define TRANSDUCER_F_LABEL       0x0F
+  #define SP_CORE_VERSION_LABEL    0x10
+  #define WRAPPER_VERSION_LABEL    0x11
+  //! @}
+
+  //! \brief Structure of a SP Board Label Message
+  //!
+  //! This structure is only used inside of the SP_LabelMessage. It
+  //! should never be allocated on it's own.
+  struct SP_LabelMessage_Fields
+  {
+    uint8 ucMsgVersion;            //!< The version of the message protocol
+    uint8 ucMsgSize;               //!< Size of the message
+    uint8 ucMsgType;               //!< Type of Label Message
+    uint8 ucSensorNumber;          //!< Sensor Number
+    uint8 ucaDescription[TRANSDUCER_LABEL_LEN];//!< 16-byte char array for the label
+  };
+
+  //! \def SP_LABELMESSAGE_SIZE
+  //! \brief The size of the SP Board Label Message (in bytes).
+  #define SP_LABELMESSAGE_SIZE sizeof(struct SP_LabelMessage_Fields)
+
+  //! \brief The union used to work with label messages
+  //!
+  //! This union is what should be allocated to work with label messages. It
+  //! allows easy access into the variuos fields of the message and makes it
+  //! easy to send and receive using byte oriented communication methods.
+  union SP_LabelMessage
+  {
+    uint8 ucByteStream[SP_LABELMESSAGE_SIZE];
+    struct SP_LabelMessage_Fields fields;
+  };
+  //! @}
+
+#endif /*MSG_H_*/
+//! @}
+//! @}
+
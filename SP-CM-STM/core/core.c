@@ -1,724 +1,1396 @@
-///////////////////////////////////////////////////////////////////////////////
-//! \file core.c
-//! \brief This is the primary file for the SP Board core
-//!
-//! This file contains the heart of the SP Board core. The function pointer
-//! and label tables are kept here and maintained by the core.
-//!
-//! @addtogroup core Core
-//! The Core Module handles all of the communication to the CP board as well
-//! as acts as the supervisor to all activities on the SP Board. The user
-//! built wrapper should interface with the Core Module as documented.
-//! @{
-///////////////////////////////////////////////////////////////////////////////
-//*****************************************************************************
-// By: Kenji Yamamoto
-//     Wireless Networks Research Lab
-//     Dept of Electrical Engineering, CEFNS
-//     Northern Arizona University
-//
-//*****************************************************************************
-
-#include <msp430x23x.h>
-#include "core.h"
-
-//******************  Software version variables  ***************************//
-//! @name Software Version Variables
-//! These variables contain ID and version information.
-//! @{
-//! \var static const uint8 g_ucaCoreVersion[VERSION_LABEL_LEN]
-//! \brief The name and version of the core
-//static const uint8 g_ucaCoreVersion[VERSION_LABEL_LEN] = "SP-Core v1.06   ";
-#define VERSION_LABEL "SP-Core v2.00   "
-
-//! \var uint8 g_ucaWrapperVersion[VERSION_LABEL_LEN]
-//! \brief Byte array to store the name and version of the wrapper.
-//uint8 g_ucaWrapperVersion[VERSION_LABEL_LEN];
-//! @}
-
-//! @name Transducer Label Variables
-//! These variables are where the labels for the transducers are stored.
-//! @{
-//******************  Transducer Labels  ************************************//
-//! \var uint8 g_ucaTransducerLabels[MAX_NUM_TRANSDUCERS][TRANSDUCER_LABEL_LEN]
-//! \brief Array of byte arrays to store the transducer labels
-
-//uint8 g_ucaTransducerLabels[MAX_NUM_TRANSDUCERS][TRANSDUCER_LABEL_LEN];
-
-
-//! @name Core Data Array
-  //! This array is where the information passed between the transducer function
-  //! and the core stored.
-  //! @var g_unaCoreData
-
-  uint16 g_unaCoreData[8]={0,0,0,0,0,0,0,0};
-
-
-//******************  Message Buffers  **************************************//
-//! @name Message Buffer Variables
-//! These variables are for the incoming and outgoing messages.
-//! @{
-//! \var union SP_32BitDataMessage  g_32DataMsg
-//! \brief All incoming and outgoing 32 Bit data messages get stored in this variable
-union SP_32BitDataMessage  g_32DataMsg;
-
-//! \var union SP_128BitDataMessage  g_128DataMsg
-//! \brief All incoming and outgoing 128 Bit data messages get stored in this variable
-union SP_128BitDataMessage g_128DataMsg; //-scb
-
-//! \var union SP_LabelMessage g_LabelMsg;
-//! \brief All outgoing label messages get stored in this variable
-union SP_LabelMessage g_LabelMsg;
-//! @}
-
-//******************  Sensor Function Table  ********************************//
-//! @name Sensor Function Table Variable
-//! This table contains the pointers to the functions used to measure the
-//! various transducers.
-//! @{
-//! \var p_TransducerFunction gp_tfSensorTable[MAX_NUM_TRANSDUCERS]
-//! \brief The table that stores the sensor function pointers
-p_TransducerFunction gp_tfSensorTable[MAX_NUM_TRANSDUCERS];
-//! @}
-
-//******************  Functions  ********************************************//
-///////////////////////////////////////////////////////////////////////////////
-//! \brief This function starts up the Core and configures hardware & RAM
-//!
-//! All of the clock setup and initial port configuration is handled in this
-//! function. At the end of the function, before the return, any additional
-//! core initilization functions are called.
-//!   \param None.
-//!   \return None.
-///////////////////////////////////////////////////////////////////////////////
-void vCORE_Initilize(void)
-{
-  // First, stop the watchdog
-  WDTCTL = WDTPW + WDTHOLD;
-
-  // Configure DCO for 16 MHz
-  DCOCTL  = CALDCO_16MHZ;
-  BCSCTL1 = CALBC1_16MHZ;
-
-
-  // Configure VLO
-  BCSCTL3 = 0x00;
-
-  // MCLK = DCO/1    SMCLK = DCO / 4
-  BCSCTL2 = SELM_0 | DIVM_0 | DIVS_2;
-
-  // ACLK = VLO / 4 = ~3 kHz
-  BCSCTL3 |= LFXT1S_2;
-  BCSCTL1 &= ~(XT2OFF + XTS);// = 0xC0
-  BCSCTL1 |= DIVA1;// = 0x20
-
-
-  // TODO: Figure out which I/O's need to be configured as non
-  //       digital I/O's to reduce power consumption
-
-  if(CoreP1OUT == DEF)
-	  P1OUT = 0x02;				 // P1.2 is the TX line, which needs to be pulled high.
-  else
-  {
-	  P1OUT = CoreP1OUT;
-	  P1OUT |= 0x02;
-  }
-  if(CoreP1DIR == DEF)
-	  P1DIR = 0xFF;				 // Port 1 - all digital I/O, all outputs,
-  else
-	  P1DIR = CoreP1DIR;
-  P1REN = 0x00;              //      all as low, pull up / pull downs disabled
-  P1SEL = 0x00;
-
-  if(CoreP2OUT == DEF)
-	  P2OUT = 0x00;
-  else
-	  P2OUT = CoreP2OUT;
-  if(CoreP2DIR == DEF)
-	  P2DIR = 0xFE;				 // Port 2 - all digital I/O, all outputs,
-  else
-  {
-	  P2DIR = CoreP2DIR;
-	  P2DIR &= ~0x1;			//Port 2.0 must be input since it is the Interrupt line from the CP.
-  }
-  P1REN = 0x00;              //      all as low, pull up / pull downs disabled
-  P2SEL = 0x00;
-
-  if(CoreP3OUT == DEF)
-	  P3OUT = 0x00;
-  else
-	  P3OUT = CoreP3OUT;
-  if(CoreP3DIR == DEF)
-	  P3DIR = 0xFF;				 // Port 3 - all digital I/O, all outputs,
-  else
-	  P3DIR = CoreP3DIR;
-  P3REN = 0x00;              //      all as low, pull up / pull downs disabled
-  P3SEL = 0x00;
-
-  if(CoreP4OUT == DEF)
-	  P4OUT = 0x00;
-  else
-	  P4OUT = CoreP4OUT;
-  if(CoreP4DIR == DEF)
-	  P4DIR = 0xFF;				 // Port 4 - all digital I/O, all outputs,
-  else
-	  P4DIR = CoreP4DIR;
-  P4REN = 0x00;              //      all as low, pull up / pull downs disabled
-  P4SEL = 0x00;
-
-  if(CoreP5OUT == DEF)
-	  P5OUT = 0x00;
-  else
-	  P5OUT = CoreP5OUT;
-  if(CoreP5DIR == DEF)
-	  P5DIR = 0xFF;				 // Port 5 - all digital I/O, all outputs,
-  else
-	  P5DIR = CoreP5DIR;
-  P5REN = 0x00;              //      all as low, pull up / pull downs disabled
-  P5SEL = 0x00;
-
-  if(CoreP6OUT == DEF)
-	  P6OUT = 0x00;
-  else
-	  P6OUT = CoreP6OUT;
-  if(CoreP6DIR == DEF)
-	  P6DIR = 0xFF;				 // Port 6 - all digital I/O, all outputs,
-  else
-	  P6DIR = CoreP6DIR;
-  P6REN = 0x00;              //      all as low, pull up / pull downs disabled
-  P6SEL = 0x00;
-
-  // All core modules get initilized now
-  vCORE_InitilizeTransducerTable();
-  vCOMM_Init(BAUD_115200);//BAUD_57600    BAUD_115200
-
-  // Enable interrupts
-  __bis_SR_register(GIE);
-}
-
-///////////////////////////////////////////////////////////////////////////////
-//! \brief Initilizes the transducer table
-//!
-//! The pointers to the transducer functions are assigned here
-//!
-//!   \param None.
-//!   \return None.
-//!   \sa vCORE_Initilize
-///////////////////////////////////////////////////////////////////////////////
-void vCORE_InitilizeTransducerTable(void)
-{
-
-  gp_tfSensorTable[0] = TRANSDUCER_0_FUNCTION;
-  gp_tfSensorTable[1] = TRANSDUCER_1_FUNCTION;
-  gp_tfSensorTable[2] = TRANSDUCER_2_FUNCTION;
-  gp_tfSensorTable[3] = TRANSDUCER_3_FUNCTION;
-  gp_tfSensorTable[4] = TRANSDUCER_4_FUNCTION;
-  gp_tfSensorTable[5] = TRANSDUCER_5_FUNCTION;
-  gp_tfSensorTable[6] = TRANSDUCER_6_FUNCTION;
-  gp_tfSensorTable[7] = TRANSDUCER_7_FUNCTION;
-  gp_tfSensorTable[8] = TRANSDUCER_8_FUNCTION;
-  gp_tfSensorTable[9] = TRANSDUCER_9_FUNCTION;
-  gp_tfSensorTable[10] = TRANSDUCER_A_FUNCTION;
-  gp_tfSensorTable[11] = TRANSDUCER_B_FUNCTION;
-  gp_tfSensorTable[12] = TRANSDUCER_C_FUNCTION;
-  gp_tfSensorTable[13] = TRANSDUCER_D_FUNCTION;
-  gp_tfSensorTable[14] = TRANSDUCER_E_FUNCTION;
-  gp_tfSensorTable[15] = TRANSDUCER_F_FUNCTION;
-
-}
-
-///////////////////////////////////////////////////////////////////////////////
-//! \brief Measure the MSP430 supply voltage
-//!
-//! Uses the ADC12 to meausre the input voltage. Uses the MEM15 register.
-//!
-//!   \param none
-//!
-//!   \return insigned int Input voltage * 100
-///////////////////////////////////////////////////////////////////////////////
-
-unsigned int unCORE_GetVoltage(void)
-{
-   int rt_volts;
-
-   ADC12CTL0 &= ~(SHT10 + SHT12 + SHT13 + MSC + ADC12OVIE + ADC12TOVIE + ENC + ADC12SC);//ADC12CTL0 &= ~0xD08F = ~1101 0000 1000 1111 //Have to turn ENC Off first
-   ADC12CTL0 |= (SHT11 + REF2_5V + REFON + ADC12ON); //ADC12CTL0 |= 0x2070 = 0010 xxxx 0111 00(11)* - 16-Cycle Hold time + Single Conversion + 2.5V Ref + RefON + ADC ON + Interrupts off + (Enable + Start)
-   ADC12CTL1 &= ~(SHS1 + SHS0 + ISSH + ADC12DIV2 + ADC12DIV1 + ADC12DIV0 + ADC12SSEL1 + ADC12SSEL0 + CONSEQ1 + CONSEQ0);//ADC12CTL1 &= ~0x0FDE = ~0000 1101 1111 1110
-   ADC12MEM15 = 0;
-   ADC12MCTL15 |= (SREF0 + INCH3 + INCH1 + INCH0); //ADC12MCTL15 |= 0x1B = x001 1011 - Reference Select + Input Select
-   ADC12MCTL15 &= ~(SREF2 + SREF1 + INCH2); // ADC12MCTL15 &= ~0x64 = 0110 0100
-   ADC12IE &= ~0x8000; //Turn off IE and clear IFG
-   ADC12IFG &= ~0x8000;
-
-   __delay_cycles(1000);
-
-   ADC12CTL1 |= (CSTARTADD3 + CSTARTADD2 + CSTARTADD1 + CSTARTADD0 + SHP); //ADC12CTL1 |= 0xF200 = 1111 0010 0000 000x - MEM15 + Internal OSC CLK + Single-Channel, Single-conversion
-   ADC12CTL0 |= ENC + ADC12SC;             // Sampling and conversion start
-
-   while(!(ADC12IFG & 0x8000));//End when something is written in. Can't sleep because we wanted to keep interrupts for users (not in core)
-
-   rt_volts = ADC12MEM15; //(0.5*Vin)/2.5V * 4095
-   ADC12IFG &= ~0x8000; //Unset IFG Flag
-   ADC12CTL0 &= ~ENC;
-   ADC12CTL0 &= ~(REFON + ADC12ON);        // turn off A/D to save power
-
-   rt_volts=(rt_volts*5)/41;
-   return (rt_volts);
-}
-
-
-///////////////////////////////////////////////////////////////////////////////
-//! \brief Set the label for a specific transducer
-//!
-//! Sets the label for a particular transducer
-//!   \param ucTransducer The transducer number to label
-//!   \param p_ucaLabel A pointer to a 16-byte array containing the label
-//!   \return None.
-///////////////////////////////////////////////////////////////////////////////
-//Not needed anymore
-/*void vCORE_SetTransducerLabel(uint8 ucTransducer, uint8 * p_ucaLabel)
-{
-  uint8 ucLoopCount;
-
-  for (ucLoopCount = 0x00; ucLoopCount < TRANSDUCER_LABEL_LEN; ucLoopCount++)
-    g_ucaTransducerLabels[ucTransducer][ucLoopCount] = p_ucaLabel[ucLoopCount];
-}*/
-
-///////////////////////////////////////////////////////////////////////////////
-//! \brief Sets the wrapper software title
-//
-//! This function tells the core the software version of the wrapper.
-//!   \param p_ucaVersion Pointer to the 16-byte descriptor
-//!   \return None.
-///////////////////////////////////////////////////////////////////////////////
-//Not needed anymore
-/*
-void vCORE_SetWrapperSoftwareString(uint8 * p_ucaVersion)
-{
-  uint8 ucLoopCount;
-
-  for (ucLoopCount = 0x00; ucLoopCount < VERSION_LABEL_LEN; ucLoopCount++)
-    g_ucaWrapperVersion[ucLoopCount] = p_ucaVersion[ucLoopCount];
-}*/
-
-///////////////////////////////////////////////////////////////////////////////
-//! \brief Assigns a function call for a particular transducer
-//!
-//! This function assigns the passed function pointer \e p_tfFunction to the
-//! passed transducer number \e ucNumber in the sensor table.
-//!   \param ucNumber The transducer number to assign.
-//!   \param p_tfFunction The function pointer to assign to \e ucNumber
-//!   \return None.
-//!   \sa core.h
-///////////////////////////////////////////////////////////////////////////////
-//Not needed anymore
-/*void vCORE_AssignFunctionToTransducer(uint8 ucNumber,
-                                      p_TransducerFunction p_tfFunction)
-{
-  gp_tfSensorTable[ucNumber] = p_tfFunction;
-}*/
-
-///////////////////////////////////////////////////////////////////////////////
-//! \brief Send the confirm packet
-//!
-//!  Confirm packet includes all the data received so CP Board can confirm it
-//!  is correct.
-//!
-//!   \param none
-//!   \sa core.h
-///////////////////////////////////////////////////////////////////////////////
-vCORE_Send_ConfirmPKT()
-{
-	// Send confirm packet that we received message
-	g_32DataMsg.fields.ucMsgVersion = SP_DATAMESSAGE_VERSION; //-scb STOP HERE
-	g_32DataMsg.fields.ucMsgType = CONFIRM_COMMAND;
-	g_32DataMsg.fields.ucMsgSize = SP_32BITDATAMESSAGE_SIZE;
-
-	// The rest of the packet should be what was sent so CP Board can confirm
-	// correct reception
-
-	vCOMM_Send32BitDataMessage(&g_32DataMsg);
-	//UARTDELETE
-	vUARTCOM_TXString("Sent Confirm Packet.\r\n",22);
-}
-
-
-///////////////////////////////////////////////////////////////////////////////
-//! \brief This functions runs the core
-//!
-//! This function runs the core. This function does not return, so all of the
-//! core setup and init must be done before the call to this function. The
-//! function waits for a data packet from the CP Board, then parses and handles
-//! it appropriately. A response packet is then sent and the core waits for
-//! the next data packet.
-//!   \param None.
-//!   \return NEVER. This function never returns
-//!   \sa msg.h
-///////////////////////////////////////////////////////////////////////////////
-void vCORE_Run(void)
-{
-  uint8 ucLoopCount;
-  uint16 unTransducerReturn; //The return parameter from the transducer function
-
-  // First, tell the CP Board that we are ready for commands
-  g_32DataMsg.fields.ucMsgVersion = SP_DATAMESSAGE_VERSION; //-scb
-  g_32DataMsg.fields.ucMsgType = ID_PKT;
-  g_32DataMsg.fields.ucMsgSize = SP_32BITDATAMESSAGE_SIZE;
-  g_32DataMsg.fields.ucSensorNumber = ID_PKT_CODE;
-
-  //ID_PKT content to tell CP Board to expect 128 bit data return packets
-  g_32DataMsg.fields.ucData1_HI_BYTE = ID_PKT_HI_BYTE1;
-  g_32DataMsg.fields.ucData1_LO_BYTE = ID_PKT_LO_BYTE1;
-  g_32DataMsg.fields.ucData2_HI_BYTE = ID_PKT_HI_BYTE2;
-  g_32DataMsg.fields.ucData2_LO_BYTE = ID_PKT_LO_BYTE2;
-
-  if(unCORE_GetVoltage() < MIN_VOLTAGE)
-  {
-	  g_32DataMsg.fields.ucData2_HI_BYTE = 0xBA;
-	  g_32DataMsg.fields.ucData2_LO_BYTE = 0xD1;
-  }
-  //Original ID_PKT content
-  //g_32DataMsg.fields.ucData1_HI_BYTE = 0xAB;
-  //g_32DataMsg.fields.ucData1_LO_BYTE = 0xCD;
-  //g_32DataMsg.fields.ucData2_HI_BYTE = 0xEF;
-  //g_32DataMsg.fields.ucData2_LO_BYTE = 0x12;
-
-
-  // Send the message
-  vCOMM_Send32BitDataMessage(&g_32DataMsg);
-  //UARTDELETE
-  vUARTCOM_TXString("ID_PKT sent.\r\n",14);
-
-  // The primary execution loop
-  while(TRUE)
-  {
-    vCOMM_WaitFor32BitDataMessage();//Wait to receive 64 bits (32 bit header, 32 bit data)
-    ucCOMM_Grab32BitDataMessageFromBuffer(&g_32DataMsg);
-    //UARTDELETE
-    vUARTCOM_TXString("Got Message from CP.\r\n",22);
-
-    switch(g_32DataMsg.fields.ucMsgType)
-    {
-      case COMMAND_PKT:
-    	  //UARTDELETE
-    	vUARTCOM_TXString("COMMAND_PKT Received\r\n",22);
-    	unTransducerReturn = 0; //default return value to 0
-    	//-scb everything in here got changed pretty much
-    	switch(g_32DataMsg.fields.ucSensorNumber)
-    	{
-    		// For each transducer, get the return value by using the function
-    		// pointer table
-    		case TRANSDUCER_0:
-   			case TRANSDUCER_1:
- 			case TRANSDUCER_2:
- 			case TRANSDUCER_3:
- 			case TRANSDUCER_4:
- 			case TRANSDUCER_5:
- 			case TRANSDUCER_6:
- 			case TRANSDUCER_7:
- 			case TRANSDUCER_8:
- 			case TRANSDUCER_9:
- 			case TRANSDUCER_A:
- 			case TRANSDUCER_B:
- 			case TRANSDUCER_C:
- 			case TRANSDUCER_D:
- 			case TRANSDUCER_E:
- 			case TRANSDUCER_F:
- 			default:
-           		break;
-    	}// END: switch(g_32DataMsg.fields.ucSensorNumber)
-
-
-    	if(gp_tfSensorTable[g_32DataMsg.fields.ucSensorNumber] != NULL)
-    		vCORE_Send_ConfirmPKT();
-
-		g_unaCoreData[0]=
-			(((uint16)g_32DataMsg.fields.ucData1_HI_BYTE) << 8) +
-			((uint16)g_32DataMsg.fields.ucData1_LO_BYTE);
-
-		g_unaCoreData[1]=
-			(((uint16)g_32DataMsg.fields.ucData2_HI_BYTE) << 8) +
-			((uint16)g_32DataMsg.fields.ucData2_LO_BYTE);
-
-		g_unaCoreData[2]= 0;
-		g_unaCoreData[3]= 0;
-		g_unaCoreData[4]= 0;
-		g_unaCoreData[5]= 0;
-		g_unaCoreData[6]= 0;
-		g_unaCoreData[7]= 0;
-
-		unTransducerReturn = //if everything went ok, unTransducerReturn > 0;
-			(*gp_tfSensorTable[g_32DataMsg.fields.ucSensorNumber])(g_unaCoreData); //pass on g_unaCoreData.
-
-		break; //END COMMAND_PKT
-
-    case REQUEST_DATA:
-
-#if SP_PACKET_SIZE_128
-        // Now send message back to CP Board
-        g_128DataMsg.fields.ucMsgVersion = SP_DATAMESSAGE_VERSION;
-        g_128DataMsg.fields.ucMsgType = REPORT_DATA;
-        g_128DataMsg.fields.ucMsgSize = SP_128BITDATAMESSAGE_SIZE;
-        g_128DataMsg.fields.ucSensorNumber = g_32DataMsg.fields.ucSensorNumber;
-
-        //unTransducerArray is an 'OK' message.
-        //If not >0, then send error message in code
-        if(!unTransducerReturn){
-        	g_128DataMsg.fields.ucMsgType = REPORT_ERROR;
-        }
-        //collect data from g_unaCoreData
-
-        g_128DataMsg.fields.ucData1_HI_BYTE = (uint8)(g_unaCoreData[0] >> 8);
-        g_128DataMsg.fields.ucData1_LO_BYTE = (uint8)g_unaCoreData[0];
-        g_128DataMsg.fields.ucData2_HI_BYTE = (uint8)(g_unaCoreData[1] >> 8);
-        g_128DataMsg.fields.ucData2_LO_BYTE = (uint8)g_unaCoreData[1];
-        g_128DataMsg.fields.ucData3_HI_BYTE = (uint8)(g_unaCoreData[2] >> 8);
-        g_128DataMsg.fields.ucData3_LO_BYTE = (uint8)g_unaCoreData[2];
-        g_128DataMsg.fields.ucData4_HI_BYTE = (uint8)(g_unaCoreData[3] >> 8);
-        g_128DataMsg.fields.ucData4_LO_BYTE = (uint8)g_unaCoreData[3];
-        g_128DataMsg.fields.ucData5_HI_BYTE = (uint8)(g_unaCoreData[4] >> 8);
-        g_128DataMsg.fields.ucData5_LO_BYTE = (uint8)g_unaCoreData[4];
-        g_128DataMsg.fields.ucData6_HI_BYTE = (uint8)(g_unaCoreData[5] >> 8);
-        g_128DataMsg.fields.ucData6_LO_BYTE = (uint8)g_unaCoreData[5];
-        g_128DataMsg.fields.ucData7_HI_BYTE = (uint8)(g_unaCoreData[6] >> 8);
-        g_128DataMsg.fields.ucData7_LO_BYTE = (uint8)g_unaCoreData[6];
-        g_128DataMsg.fields.ucData8_HI_BYTE = (uint8)(g_unaCoreData[7] >> 8);
-        g_128DataMsg.fields.ucData8_LO_BYTE = (uint8)g_unaCoreData[7];
-        // Send the message
-        vCOMM_Send128BitDataMessage(&g_128DataMsg);
-        //UARTDELETE
-        vUARTCOM_TXString("Sent Return Message\r\n",21);
-#else
-        // Now send message back to CP Board
-        g_32DataMsg.fields.ucMsgVersion = SP_DATAMESSAGE_VERSION;
-        g_32DataMsg.fields.ucMsgType = REPORT_DATA;
-        g_32DataMsg.fields.ucMsgSize = SP_32BITDATAMESSAGE_SIZE;
-
-
-        //unTransducerArray is an 'OK' message.
-        //If not >0, then send error message in code
-        if(unTransducerReturn){
-        //collect data from g_unaCoreData
-        	g_32DataMsg.fields.ucData1_HI_BYTE = (uint8)(g_unaCoreData[0] >> 8);
-        	g_32DataMsg.fields.ucData1_LO_BYTE = (uint8)g_unaCoreData[0];
-        	g_32DataMsg.fields.ucData2_HI_BYTE = (uint8)(g_unaCoreData[1] >> 8);
-        	g_32DataMsg.fields.ucData2_LO_BYTE = (uint8)g_unaCoreData[1];
-        }
-        else
-        {//This is my ERRORMSG (EBB0B356) for now :P
-        	g_32DataMsg.fields.ucData1_HI_BYTE = 0xEB;
-        	g_32DataMsg.fields.ucData1_LO_BYTE = 0xB0;
-        	g_32DataMsg.fields.ucData2_HI_BYTE = 0xB3;
-        	g_32DataMsg.fields.ucData2_LO_BYTE = 0x56;
-        }
-        // Send the message
-        vCOMM_Send32BitDataMessage(&g_32DataMsg);
-        //UARTDELETE
-        vUARTCOM_TXString("Sent Data Message\r\n",19);
-
-
-
-#endif
-        break; //END REQUEST_DATA
-
-      case REQUEST_LABEL:
-        // Format first part of return message
-        g_LabelMsg.fields.ucMsgVersion = SP_LABELMESSAGE_VERSION;
-        g_LabelMsg.fields.ucMsgType = REPORT_LABEL;
-        g_LabelMsg.fields.ucMsgSize = SP_LABELMESSAGE_SIZE;
-        g_LabelMsg.fields.ucSensorNumber = g_32DataMsg.fields.ucSensorNumber;
-
-        switch(g_LabelMsg.fields.ucSensorNumber)
-        {
-          // For each transducer, use the table to get the label
-          case TRANSDUCER_0_LABEL:
-              for (ucLoopCount = 0x00;
-                   ucLoopCount < TRANSDUCER_LABEL_LEN;
-                   ucLoopCount++)
-              g_LabelMsg.fields.ucaDescription[ucLoopCount] = TRANSDUCER_0_LABEL_TXT[ucLoopCount];
-              break;
-          case TRANSDUCER_1_LABEL:
-              for (ucLoopCount = 0x00;
-                   ucLoopCount < TRANSDUCER_LABEL_LEN;
-                   ucLoopCount++)
-              g_LabelMsg.fields.ucaDescription[ucLoopCount] = TRANSDUCER_1_LABEL_TXT[ucLoopCount];
-              break;
-
-          case TRANSDUCER_2_LABEL:
-              for (ucLoopCount = 0x00;
-                   ucLoopCount < TRANSDUCER_LABEL_LEN;
-                   ucLoopCount++)
-              g_LabelMsg.fields.ucaDescription[ucLoopCount] = TRANSDUCER_2_LABEL_TXT[ucLoopCount];
-              break;
-
-          case TRANSDUCER_3_LABEL:
-              for (ucLoopCount = 0x00;
-                   ucLoopCount < TRANSDUCER_LABEL_LEN;
-                   ucLoopCount++)
-              g_LabelMsg.fields.ucaDescription[ucLoopCount] = TRANSDUCER_3_LABEL_TXT[ucLoopCount];
-              break;
-
-          case TRANSDUCER_4_LABEL:
-              for (ucLoopCount = 0x00;
-                   ucLoopCount < TRANSDUCER_LABEL_LEN;
-                   ucLoopCount++)
-              g_LabelMsg.fields.ucaDescription[ucLoopCount] = TRANSDUCER_4_LABEL_TXT[ucLoopCount];
-              break;
-
-          case TRANSDUCER_5_LABEL:
-              for (ucLoopCount = 0x00;
-                   ucLoopCount < TRANSDUCER_LABEL_LEN;
-                   ucLoopCount++)
-              g_LabelMsg.fields.ucaDescription[ucLoopCount] = TRANSDUCER_5_LABEL_TXT[ucLoopCount];
-              break;
-
-          case TRANSDUCER_6_LABEL:
-              for (ucLoopCount = 0x00;
-                   ucLoopCount < TRANSDUCER_LABEL_LEN;
-                   ucLoopCount++)
-              g_LabelMsg.fields.ucaDescription[ucLoopCount] = TRANSDUCER_6_LABEL_TXT[ucLoopCount];
-              break;
-
-          case TRANSDUCER_7_LABEL:
-              for (ucLoopCount = 0x00;
-                   ucLoopCount < TRANSDUCER_LABEL_LEN;
-                   ucLoopCount++)
-              g_LabelMsg.fields.ucaDescription[ucLoopCount] = TRANSDUCER_7_LABEL_TXT[ucLoopCount];
-              break;
-
-          case TRANSDUCER_8_LABEL:
-              for (ucLoopCount = 0x00;
-                   ucLoopCount < TRANSDUCER_LABEL_LEN;
-                   ucLoopCount++)
-              g_LabelMsg.fields.ucaDescription[ucLoopCount] = TRANSDUCER_8_LABEL_TXT[ucLoopCount];
-              break;
-
-          case TRANSDUCER_9_LABEL:
-              for (ucLoopCount = 0x00;
-                   ucLoopCount < TRANSDUCER_LABEL_LEN;
-                   ucLoopCount++)
-              g_LabelMsg.fields.ucaDescription[ucLoopCount] = TRANSDUCER_9_LABEL_TXT[ucLoopCount];
-              break;
-
-          case TRANSDUCER_A_LABEL:
-              for (ucLoopCount = 0x00;
-                   ucLoopCount < TRANSDUCER_LABEL_LEN;
-                   ucLoopCount++)
-              g_LabelMsg.fields.ucaDescription[ucLoopCount] = TRANSDUCER_A_LABEL_TXT[ucLoopCount];
-              break;
-
-          case TRANSDUCER_B_LABEL:
-              for (ucLoopCount = 0x00;
-                   ucLoopCount < TRANSDUCER_LABEL_LEN;
-                   ucLoopCount++)
-              g_LabelMsg.fields.ucaDescription[ucLoopCount] = TRANSDUCER_B_LABEL_TXT[ucLoopCount];
-              break;
-
-          case TRANSDUCER_C_LABEL:
-              for (ucLoopCount = 0x00;
-                   ucLoopCount < TRANSDUCER_LABEL_LEN;
-                   ucLoopCount++)
-              g_LabelMsg.fields.ucaDescription[ucLoopCount] = TRANSDUCER_C_LABEL_TXT[ucLoopCount];
-              break;
-
-          case TRANSDUCER_D_LABEL:
-              for (ucLoopCount = 0x00;
-                   ucLoopCount < TRANSDUCER_LABEL_LEN;
-                   ucLoopCount++)
-              g_LabelMsg.fields.ucaDescription[ucLoopCount] = TRANSDUCER_D_LABEL_TXT[ucLoopCount];
-              break;
-
-          case TRANSDUCER_E_LABEL:
-              for (ucLoopCount = 0x00;
-                   ucLoopCount < TRANSDUCER_LABEL_LEN;
-                   ucLoopCount++)
-              g_LabelMsg.fields.ucaDescription[ucLoopCount] = TRANSDUCER_E_LABEL_TXT[ucLoopCount];
-              break;
-
-          case TRANSDUCER_F_LABEL:
-              for (ucLoopCount = 0x00;
-                   ucLoopCount < TRANSDUCER_LABEL_LEN;
-                   ucLoopCount++)
-              g_LabelMsg.fields.ucaDescription[ucLoopCount] = TRANSDUCER_F_LABEL_TXT[ucLoopCount];
-              break;
-
-          case SP_CORE_VERSION:
-            for (ucLoopCount = 0x00;
-                 ucLoopCount < VERSION_LABEL_LEN;
-                 ucLoopCount++)
-              g_LabelMsg.fields.ucaDescription[ucLoopCount] = VERSION_LABEL[ucLoopCount];
-            break;
-
-          case WRAPPER_VERSION:
-            for (ucLoopCount = 0x00;
-                 ucLoopCount < VERSION_LABEL_LEN;
-                 ucLoopCount++)
-              g_LabelMsg.fields.ucaDescription[ucLoopCount] = SOFTWAREVERSION[ucLoopCount];
-                //g_ucaWrapperVersion[ucLoopCount];
-            break;
-          default:
-            for (ucLoopCount = 0x00;
-                 ucLoopCount < TRANSDUCER_LABEL_LEN;
-                 ucLoopCount++)
-              g_LabelMsg.fields.ucaDescription[ucLoopCount] = "CANNOT COMPUTE!!"[ucLoopCount];
-                //g_ucaTransducerLabels[g_LabelMsg.fields.ucSensorNumber][ucLoopCount];
-              break;
-
-
-        }// END: switch(g_LabelMsg.fields.ucSensorNumber)
-
-        // Send the label message
-        vCOMM_SendLabelMessage(&g_LabelMsg);
-        break; //END REQUEST_LABEL
-
-      //If the CP Board sent a Handshake message, respond with this packet.
-      case HAND_SHK:
-    	  //UARTDELETE
-    	  vUARTCOM_TXString("HAND_SHK Received\r\n",19);
-    	  g_32DataMsg.fields.ucMsgVersion = SP_DATAMESSAGE_VERSION; //-scb
-    	  g_32DataMsg.fields.ucMsgType = HAND_SHK;
-    	  g_32DataMsg.fields.ucMsgSize = SP_32BITDATAMESSAGE_SIZE;
-    	  g_32DataMsg.fields.ucSensorNumber = HAND_SHK;
-    	  g_32DataMsg.fields.ucData1_HI_BYTE = 0x12;
-    	  g_32DataMsg.fields.ucData1_LO_BYTE = 0xEF;
-    	  g_32DataMsg.fields.ucData2_HI_BYTE = 0xCD;
-    	  g_32DataMsg.fields.ucData2_LO_BYTE = 0xAB;
-    	  vCOMM_Send32BitDataMessage(&g_32DataMsg);
-    	  //UARTDELETE
-    	  vUARTCOM_TXString("HAND_SHK sent\r\n",15);
-    	  break; //END HAND_SHK
-      default:
-        //_never_executed();//Unless there's an error ;)
-    	vUARTCOM_TXString("Unknown Message\r\n",17);
-    	vUARTCOM_TXString("Message Version: ",17);
-    	vUARTCOM_TXString((char*)(g_32DataMsg.fields.ucMsgVersion+32),1);
-    	vUARTCOM_TXString("\r\nMessage Type: ",16);
-    	vUARTCOM_TXString((char*)(g_32DataMsg.fields.ucMsgType+32),1);
-    	vUARTCOM_TXString("\r\nMessage Size: ",16);
-    	vUARTCOM_TXString((char*)(g_32DataMsg.fields.ucMsgSize+32),1);
-    	vUARTCOM_TXString("\r\nSensor Number: ",17);
-    	vUARTCOM_TXString((char*)(g_32DataMsg.fields.ucSensorNumber+32),1);
-    	vUARTCOM_TXString("\r\nFirst Byte: ",14);
-    	vUARTCOM_TXString((char*)(g_32DataMsg.fields.ucData1_HI_BYTE+32),1);
-    	vUARTCOM_TXString("\r\n",2);
-
-    	  g_32DataMsg.fields.ucMsgVersion = SP_DATAMESSAGE_VERSION; //-scb
-    	  g_32DataMsg.fields.ucMsgType = REPORT_ERROR;
-    	  g_32DataMsg.fields.ucMsgSize = SP_32BITDATAMESSAGE_SIZE;
-    	  g_32DataMsg.fields.ucSensorNumber = ID_PKT_CODE;
-
-    	  //ID_PKT content to tell CP Board to expect 128 bit data return packets
-    	  g_32DataMsg.fields.ucData1_HI_BYTE = PACKET_ERROR_CODE;
-    	  vCOMM_Send32BitDataMessage(&g_32DataMsg);
-
-        break; //END default
-    }// END: switch(g_32DataMsg.fields.ucMsgType)
-    __bis_SR_register(LPM3_bits);//LPM4 works too, but then no timers whatsoever. We did not want to limit the Applications that much.
-    // After Tranceiver code has been executed, wait until you receive the
-    // REQUEST_DATA packet and then send the packet. You can then go into
-    // sleep mode again. It is expected that the SP will be turned off by
-    // the CP. If not, in LPM3 it is still ready to receive messages.
-  }// END: while(TRUE)
-}
-
-//! @}
+///////////////////////////////////////////////////////////////////////////////
+//! \file core.c
+//! \brief This is the primary file for the SP Board core
+//!
+//! This file contains the heart of the SP Board core. The function pointer
+//! and label tables are kept here and maintained by the core.
+//!
+//! @addtogroup core Core
+//! The Core Module handles all of the communication to the CP board as well
+//! as acts as the supervisor to all activities on the SP Board. The user
+//! built wrapper should interface with the Core Module as documented.
+//! @{
+///////////////////////////////////////////////////////////////////////////////
+//*****************************************************************************
+// By: Kenji Yamamoto
+//     Wireless Networks Research Lab
+//     Dept of Electrical Engineering, CEFNS
+//     Northern Arizona University
+//
+//*****************************************************************************
+
+#include <msp430x23x.h>
+#include "core.h"
+
+// The deadband is compared against whole data words, which are not
+// readings once the 5TM fields are packed into them
+#if SP_REPORT_BY_EXCEPTION && SP_PACKET_PACKED_5TM
+#error "SP_REPORT_BY_EXCEPTION does not work with SP_PACKET_PACKED_5TM"
+#endif
+
+//******************  Software version variables  ***************************//
+//! @name Software Version Variables
+//! These variables contain ID and version information.
+//! @{
+//! \var static const uint8 g_ucaCoreVersion[VERSION_LABEL_LEN]
+//! \brief The name and version of the core
+//static const uint8 g_ucaCoreVersion[VERSION_LABEL_LEN] = "SP-Core v1.06   ";
+#define VERSION_LABEL "SP-Core v2.00   "
+
+//! \var uint8 g_ucaWrapperVersion[VERSION_LABEL_LEN]
+//! \brief Byte array to store the name and version of the wrapper.
+//uint8 g_ucaWrapperVersion[VERSION_LABEL_LEN];
+//! @}
+
+//! @name Transducer Label Variables
+//! These variables are where the labels for the transducers are stored.
+//! @{
+//******************  Transducer Labels  ************************************//
+//! \var uint8 g_ucaTransducerLabels[MAX_NUM_TRANSDUCERS][TRANSDUCER_LABEL_LEN]
+//! \brief Array of byte arrays to store the transducer labels
+
+//uint8 g_ucaTransducerLabels[MAX_NUM_TRANSDUCERS][TRANSDUCER_LABEL_LEN];
+
+
+//! @name Core Data Array
+  //! This array is where the information passed between the transducer function
+  //! and the core stored.
+  //! @var g_unaCoreData
+
+  uint16 g_unaCoreData[8]={0,0,0,0,0,0,0,0};
+
+#if SP_REPORT_BY_EXCEPTION
+//! @name Report Deadband Variables
+//! These variables hold the deadband of each transducer and the last report
+//! sent for it, see SP_REPORT_BY_EXCEPTION.
+//! @{
+//! \var uint16 g_unaCoreDeadband[MAX_NUM_TRANSDUCERS]
+//! \brief The deadband of each transducer, 0 if it always reports in full
+uint16 g_unaCoreDeadband[MAX_NUM_TRANSDUCERS];
+//! \var uint16 g_unaCoreLastReport[MAX_NUM_TRANSDUCERS][8]
+//! \brief The data words of the last full report of each transducer
+uint16 g_unaCoreLastReport[MAX_NUM_TRANSDUCERS][8];
+//! \var uint16 g_unCoreLastReportValid
+//! \brief A bit for each transducer with a last report in g_unaCoreLastReport
+uint16 g_unCoreLastReportValid;
+//! @}
+#endif
+
+
+//******************  Message Buffers  **************************************//
+//! @name Message Buffer Variables
+//! These variables are for the incoming and outgoing messages.
+//! @{
+//! \var union SP_32BitDataMessage  g_32DataMsg
+//! \brief Outgoing 32 Bit data messages that do not answer a request get
+//! stored in this variable
+union SP_32BitDataMessage  g_32DataMsg;
+
+//! \var union SP_32BitDataMessage * g_p32DataMsg
+//! \brief Points to the 32 Bit data message being handled
+//!
+//! This is the request in its RX message buffer while one is being handled,
+//! and the reply is built in place. Otherwise it points to g_32DataMsg.
+union SP_32BitDataMessage * g_p32DataMsg;
+
+//! \var union SP_128BitDataMessage  g_128DataMsg
+//! \brief All incoming and outgoing 128 Bit data messages get stored in this variable
+union SP_128BitDataMessage g_128DataMsg; //-scb
+
+#if SP_PACKET_VARIABLE
+//! \var union SP_VarDataMessage g_VarDataMsg
+//! \brief Outgoing variable length data reports get stored in this variable
+union SP_VarDataMessage g_VarDataMsg;
+#endif
+
+//! \var union SP_LabelMessage g_LabelMsg;
+//! \brief All outgoing label messages get stored in this variable
+union SP_LabelMessage g_LabelMsg;
+//! @}
+
+//******************  Sensor Function Table  ********************************//
+//! @name Sensor Function Table Variable
+//! This table contains the pointers to the functions used to measure the
+//! various transducers.
+//! @{
+//! \var p_TransducerFunction gp_tfSensorTable[MAX_NUM_TRANSDUCERS]
+//! \brief The table that stores the sensor function pointers
+p_TransducerFunction gp_tfSensorTable[MAX_NUM_TRANSDUCERS];
+//! @}
+
+//******************  Message Handler State  ********************************//
+//! @name Message Handler Variables
+//! These variables carry state from one message handler to the next.
+//! @{
+//! \var uint16 g_unCoreTransducerReturn
+//! \brief The return value of the last transducer function, reported on
+//! the next REQUEST_DATA
+uint16 g_unCoreTransducerReturn;
+//! \var uint8 g_ucCoreIDPKTSent
+//! \brief Whether the CP Board has been sent the ID_PKT
+uint8 g_ucCoreIDPKTSent;
+//! @}
+
+//******************  Functions  ********************************************//
+///////////////////////////////////////////////////////////////////////////////
+//! \brief This function starts up the Core and configures hardware & RAM
+//!
+//! All of the clock setup and initial port configuration is handled in this
+//! function. At the end of the function, before the return, any additional
+//! core initilization functions are called.
+//!   \param None.
+//!   \return None.
+///////////////////////////////////////////////////////////////////////////////
+void vCORE_Initilize(void)
+{
+#if SP_REPORT_BY_EXCEPTION
+  uint8 ucLoopCount;
+#endif
+
+  // First, stop the watchdog
+  WDTCTL = WDTPW + WDTHOLD;
+
+  // Configure DCO for 16 MHz
+  DCOCTL  = CALDCO_16MHZ;
+  BCSCTL1 = CALBC1_16MHZ;
+
+
+  // Configure VLO
+  BCSCTL3 = 0x00;
+
+#if SP_SMCLK_16MHZ
+  // MCLK = DCO/1    SMCLK = DCO/1
+  BCSCTL2 = SELM_0 | DIVM_0 | DIVS_0;
+#else
+  // MCLK = DCO/1    SMCLK = DCO / 4
+  BCSCTL2 = SELM_0 | DIVM_0 | DIVS_2;
+#endif
+
+  // ACLK = VLO / 4 = ~3 kHz
+  BCSCTL3 |= LFXT1S_2;
+  BCSCTL1 &= ~(XT2OFF + XTS);// = 0xC0
+  BCSCTL1 |= DIVA1;// = 0x20
+
+
+  // TODO: Figure out which I/O's need to be configured as non
+  //       digital I/O's to reduce power consumption
+
+  if(CoreP1OUT == DEF)
+	  P1OUT = 0x02;				 // P1.2 is the TX line, which needs to be pulled high.
+  else
+  {
+	  P1OUT = CoreP1OUT;
+	  P1OUT |= 0x02;
+  }
+  if(CoreP1DIR == DEF)
+	  P1DIR = 0xFF;				 // Port 1 - all digital I/O, all outputs,
+  else
+	  P1DIR = CoreP1DIR;
+  P1REN = 0x00;              //      all as low, pull up / pull downs disabled
+  P1SEL = 0x00;
+
+  if(CoreP2OUT == DEF)
+	  P2OUT = 0x00;
+  else
+	  P2OUT = CoreP2OUT;
+  if(CoreP2DIR == DEF)
+	  P2DIR = 0xFE;				 // Port 2 - all digital I/O, all outputs,
+  else
+  {
+	  P2DIR = CoreP2DIR;
+	  P2DIR &= ~0x1;			//Port 2.0 must be input since it is the Interrupt line from the CP.
+  }
+  P1REN = 0x00;              //      all as low, pull up / pull downs disabled
+  P2SEL = 0x00;
+
+  if(CoreP3OUT == DEF)
+	  P3OUT = 0x00;
+  else
+	  P3OUT = CoreP3OUT;
+  if(CoreP3DIR == DEF)
+	  P3DIR = 0xFF;				 // Port 3 - all digital I/O, all outputs,
+  else
+	  P3DIR = CoreP3DIR;
+  P3REN = 0x00;              //      all as low, pull up / pull downs disabled
+  P3SEL = 0x00;
+
+  if(CoreP4OUT == DEF)
+	  P4OUT = 0x00;
+  else
+	  P4OUT = CoreP4OUT;
+  if(CoreP4DIR == DEF)
+	  P4DIR = 0xFF;				 // Port 4 - all digital I/O, all outputs,
+  else
+	  P4DIR = CoreP4DIR;
+  P4REN = 0x00;              //      all as low, pull up / pull downs disabled
+  P4SEL = 0x00;
+
+  if(CoreP5OUT == DEF)
+	  P5OUT = 0x00;
+  else
+	  P5OUT = CoreP5OUT;
+  if(CoreP5DIR == DEF)
+	  P5DIR = 0xFF;				 // Port 5 - all digital I/O, all outputs,
+  else
+	  P5DIR = CoreP5DIR;
+  P5REN = 0x00;              //      all as low, pull up / pull downs disabled
+  P5SEL = 0x00;
+
+  if(CoreP6OUT == DEF)
+	  P6OUT = 0x00;
+  else
+	  P6OUT = CoreP6OUT;
+  if(CoreP6DIR == DEF)
+	  P6DIR = 0xFF;				 // Port 6 - all digital I/O, all outputs,
+  else
+	  P6DIR = CoreP6DIR;
+  P6REN = 0x00;              //      all as low, pull up / pull downs disabled
+  P6SEL = 0x00;
+
+  // All core modules get initilized now
+  vCORE_InitilizeTransducerTable();
+#if SP_REPORT_BY_EXCEPTION
+  // Every transducer starts out reporting in full
+  for(ucLoopCount = 0x00; ucLoopCount < MAX_NUM_TRANSDUCERS; ucLoopCount++)
+    g_unaCoreDeadband[ucLoopCount] = 0x0000;
+  g_unCoreLastReportValid = 0x0000;
+#endif
+  // With SP_COMM_AUTOBAUD this is replaced by the rate the CP Board uses
+  vCOMM_Init(BAUD_115200);//BAUD_57600    BAUD_115200
+
+  // Enable interrupts
+  __bis_SR_register(GIE);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Initilizes the transducer table
+//!
+//! The pointers to the transducer functions are assigned here
+//!
+//!   \param None.
+//!   \return None.
+//!   \sa vCORE_Initilize
+///////////////////////////////////////////////////////////////////////////////
+void vCORE_InitilizeTransducerTable(void)
+{
+
+  gp_tfSensorTable[0] = TRANSDUCER_0_FUNCTION;
+  gp_tfSensorTable[1] = TRANSDUCER_1_FUNCTION;
+  gp_tfSensorTable[2] = TRANSDUCER_2_FUNCTION;
+  gp_tfSensorTable[3] = TRANSDUCER_3_FUNCTION;
+  gp_tfSensorTable[4] = TRANSDUCER_4_FUNCTION;
+  gp_tfSensorTable[5] = TRANSDUCER_5_FUNCTION;
+  gp_tfSensorTable[6] = TRANSDUCER_6_FUNCTION;
+  gp_tfSensorTable[7] = TRANSDUCER_7_FUNCTION;
+  gp_tfSensorTable[8] = TRANSDUCER_8_FUNCTION;
+  gp_tfSensorTable[9] = TRANSDUCER_9_FUNCTION;
+  gp_tfSensorTable[10] = TRANSDUCER_A_FUNCTION;
+  gp_tfSensorTable[11] = TRANSDUCER_B_FUNCTION;
+  gp_tfSensorTable[12] = TRANSDUCER_C_FUNCTION;
+  gp_tfSensorTable[13] = TRANSDUCER_D_FUNCTION;
+  gp_tfSensorTable[14] = TRANSDUCER_E_FUNCTION;
+  gp_tfSensorTable[15] = TRANSDUCER_F_FUNCTION;
+
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Measure the MSP430 supply voltage
+//!
+//! Uses the ADC12 to meausre the input voltage. Uses the MEM15 register.
+//!
+//!   \param none
+//!
+//!   \return insigned int Input voltage * 100
+///////////////////////////////////////////////////////////////////////////////
+
+unsigned int unCORE_GetVoltage(void)
+{
+   int rt_volts;
+
+   ADC12CTL0 &= ~(SHT10 + SHT12 + SHT13 + MSC + ADC12OVIE + ADC12TOVIE + ENC + ADC12SC);//ADC12CTL0 &= ~0xD08F = ~1101 0000 1000 1111 //Have to turn ENC Off first
+   ADC12CTL0 |= (SHT11 + REF2_5V + REFON + ADC12ON); //ADC12CTL0 |= 0x2070 = 0010 xxxx 0111 00(11)* - 16-Cycle Hold time + Single Conversion + 2.5V Ref + RefON + ADC ON + Interrupts off + (Enable + Start)
+   ADC12CTL1 &= ~(SHS1 + SHS0 + ISSH + ADC12DIV2 + ADC12DIV1 + ADC12DIV0 + ADC12SSEL1 + ADC12SSEL0 + CONSEQ1 + CONSEQ0);//ADC12CTL1 &= ~0x0FDE = ~0000 1101 1111 1110
+   ADC12MEM15 = 0;
+   ADC12MCTL15 |= (SREF0 + INCH3 + INCH1 + INCH0); //ADC12MCTL15 |= 0x1B = x001 1011 - Reference Select + Input Select
+   ADC12MCTL15 &= ~(SREF2 + SREF1 + INCH2); // ADC12MCTL15 &= ~0x64 = 0110 0100
+   ADC12IE &= ~0x8000; //Turn off IE and clear IFG
+   ADC12IFG &= ~0x8000;
+
+   __delay_cycles(1000);
+
+   ADC12CTL1 |= (CSTARTADD3 + CSTARTADD2 + CSTARTADD1 + CSTARTADD0 + SHP); //ADC12CTL1 |= 0xF200 = 1111 0010 0000 000x - MEM15 + Internal OSC CLK + Single-Channel, Single-conversion
+   ADC12CTL0 |= ENC + ADC12SC;             // Sampling and conversion start
+
+   while(!(ADC12IFG & 0x8000));//End when something is written in. Can't sleep because we wanted to keep interrupts for users (not in core)
+
+   rt_volts = ADC12MEM15; //(0.5*Vin)/2.5V * 4095
+   ADC12IFG &= ~0x8000; //Unset IFG Flag
+   ADC12CTL0 &= ~ENC;
+   ADC12CTL0 &= ~(REFON + ADC12ON);        // turn off A/D to save power
+
+   rt_volts=(rt_volts*5)/41;
+   return (rt_volts);
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Set the label for a specific transducer
+//!
+//! Sets the label for a particular transducer
+//!   \param ucTransducer The transducer number to label
+//!   \param p_ucaLabel A pointer to a 16-byte array containing the label
+//!   \return None.
+///////////////////////////////////////////////////////////////////////////////
+//Not needed anymore
+/*void vCORE_SetTransducerLabel(uint8 ucTransducer, uint8 * p_ucaLabel)
+{
+  uint8 ucLoopCount;
+
+  for (ucLoopCount = 0x00; ucLoopCount < TRANSDUCER_LABEL_LEN; ucLoopCount++)
+    g_ucaTransducerLabels[ucTransducer][ucLoopCount] = p_ucaLabel[ucLoopCount];
+}*/
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Sets the wrapper software title
+//
+//! This function tells the core the software version of the wrapper.
+//!   \param p_ucaVersion Pointer to the 16-byte descriptor
+//!   \return None.
+///////////////////////////////////////////////////////////////////////////////
+//Not needed anymore
+/*
+void vCORE_SetWrapperSoftwareString(uint8 * p_ucaVersion)
+{
+  uint8 ucLoopCount;
+
+  for (ucLoopCount = 0x00; ucLoopCount < VERSION_LABEL_LEN; ucLoopCount++)
+    g_ucaWrapperVersion[ucLoopCount] = p_ucaVersion[ucLoopCount];
+}*/
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Assigns a function call for a particular transducer
+//!
+//! This function assigns the passed function pointer \e p_tfFunction to the
+//! passed transducer number \e ucNumber in the sensor table.
+//!   \param ucNumber The transducer number to assign.
+//!   \param p_tfFunction The function pointer to assign to \e ucNumber
+//!   \return None.
+//!   \sa core.h
+///////////////////////////////////////////////////////////////////////////////
+//Not needed anymore
+/*void vCORE_AssignFunctionToTransducer(uint8 ucNumber,
+                                      p_TransducerFunction p_tfFunction)
+{
+  gp_tfSensorTable[ucNumber] = p_tfFunction;
+}*/
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Send the confirm packet
+//!
+//!  Confirm packet includes all the data received so CP Board can confirm it
+//!  is correct.
+//!
+//!   \param none
+//!   \sa core.h
+///////////////////////////////////////////////////////////////////////////////
+vCORE_Send_ConfirmPKT()
+{
+	// Send confirm packet that we received message
+	g_p32DataMsg->fields.ucMsgVersion = SP_DATAMESSAGE_VERSION; //-scb STOP HERE
+	g_p32DataMsg->fields.ucMsgType = CONFIRM_COMMAND;
+	g_p32DataMsg->fields.ucMsgSize = SP_32BITDATAMESSAGE_SIZE;
+
+	// The rest of the packet should be what was sent so CP Board can confirm
+	// correct reception
+
+	vCOMM_Send32BitDataMessage(g_p32DataMsg);
+	//UARTDELETE
+	vUARTCOM_TXString("Sent Confirm Packet.\r\n",22);
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Sends the label message for a sensor number
+//!
+//!   \param ucSensorNumber The transducer or version label to send
+//!   \sa msg.h
+///////////////////////////////////////////////////////////////////////////////
+void vCORE_Send_LabelPKT(uint8 ucSensorNumber)
+{
+  uint8 ucLoopCount;
+
+  // Format first part of return message
+  g_LabelMsg.fields.ucMsgVersion = SP_LABELMESSAGE_VERSION;
+  g_LabelMsg.fields.ucMsgType = REPORT_LABEL;
+  g_LabelMsg.fields.ucMsgSize = SP_LABELMESSAGE_SIZE;
+  g_LabelMsg.fields.ucSensorNumber = ucSensorNumber;
+
+  switch(g_LabelMsg.fields.ucSensorNumber)
+  {
+    // For each transducer, use the table to get the label
+    case TRANSDUCER_0_LABEL:
+        for (ucLoopCount = 0x00;
+             ucLoopCount < TRANSDUCER_LABEL_LEN;
+             ucLoopCount++)
+        g_LabelMsg.fields.ucaDescription[ucLoopCount] = TRANSDUCER_0_LABEL_TXT[ucLoopCount];
+        break;
+    case TRANSDUCER_1_LABEL:
+        for (ucLoopCount = 0x00;
+             ucLoopCount < TRANSDUCER_LABEL_LEN;
+             ucLoopCount++)
+        g_LabelMsg.fields.ucaDescription[ucLoopCount] = TRANSDUCER_1_LABEL_TXT[ucLoopCount];
+        break;
+
+    case TRANSDUCER_2_LABEL:
+        for (ucLoopCount = 0x00;
+             ucLoopCount < TRANSDUCER_LABEL_LEN;
+             ucLoopCount++)
+        g_LabelMsg.fields.ucaDescription[ucLoopCount] = TRANSDUCER_2_LABEL_TXT[ucLoopCount];
+        break;
+
+    case TRANSDUCER_3_LABEL:
+        for (ucLoopCount = 0x00;
+             ucLoopCount < TRANSDUCER_LABEL_LEN;
+             ucLoopCount++)
+        g_LabelMsg.fields.ucaDescription[ucLoopCount] = TRANSDUCER_3_LABEL_TXT[ucLoopCount];
+        break;
+
+    case TRANSDUCER_4_LABEL:
+        for (ucLoopCount = 0x00;
+             ucLoopCount < TRANSDUCER_LABEL_LEN;
+             ucLoopCount++)
+        g_LabelMsg.fields.ucaDescription[ucLoopCount] = TRANSDUCER_4_LABEL_TXT[ucLoopCount];
+        break;
+
+    case TRANSDUCER_5_LABEL:
+        for (ucLoopCount = 0x00;
+             ucLoopCount < TRANSDUCER_LABEL_LEN;
+             ucLoopCount++)
+        g_LabelMsg.fields.ucaDescription[ucLoopCount] = TRANSDUCER_5_LABEL_TXT[ucLoopCount];
+        break;
+
+    case TRANSDUCER_6_LABEL:
+        for (ucLoopCount = 0x00;
+             ucLoopCount < TRANSDUCER_LABEL_LEN;
+             ucLoopCount++)
+        g_LabelMsg.fields.ucaDescription[ucLoopCount] = TRANSDUCER_6_LABEL_TXT[ucLoopCount];
+        break;
+
+    case TRANSDUCER_7_LABEL:
+        for (ucLoopCount = 0x00;
+             ucLoopCount < TRANSDUCER_LABEL_LEN;
+             ucLoopCount++)
+        g_LabelMsg.fields.ucaDescription[ucLoopCount] = TRANSDUCER_7_LABEL_TXT[ucLoopCount];
+        break;
+
+    case TRANSDUCER_8_LABEL:
+        for (ucLoopCount = 0x00;
+             ucLoopCount < TRANSDUCER_LABEL_LEN;
+             ucLoopCount++)
+        g_LabelMsg.fields.ucaDescription[ucLoopCount] = TRANSDUCER_8_LABEL_TXT[ucLoopCount];
+        break;
+
+    case TRANSDUCER_9_LABEL:
+        for (ucLoopCount = 0x00;
+             ucLoopCount < TRANSDUCER_LABEL_LEN;
+             ucLoopCount++)
+        g_LabelMsg.fields.ucaDescription[ucLoopCount] = TRANSDUCER_9_LABEL_TXT[ucLoopCount];
+        break;
+
+    case TRANSDUCER_A_LABEL:
+        for (ucLoopCount = 0x00;
+             ucLoopCount < TRANSDUCER_LABEL_LEN;
+             ucLoopCount++)
+        g_LabelMsg.fields.ucaDescription[ucLoopCount] = TRANSDUCER_A_LABEL_TXT[ucLoopCount];
+        break;
+
+    case TRANSDUCER_B_LABEL:
+        for (ucLoopCount = 0x00;
+             ucLoopCount < TRANSDUCER_LABEL_LEN;
+             ucLoopCount++)
+        g_LabelMsg.fields.ucaDescription[ucLoopCount] = TRANSDUCER_B_LABEL_TXT[ucLoopCount];
+        break;
+
+    case TRANSDUCER_C_LABEL:
+        for (ucLoopCount = 0x00;
+             ucLoopCount < TRANSDUCER_LABEL_LEN;
+             ucLoopCount++)
+        g_LabelMsg.fields.ucaDescription[ucLoopCount] = TRANSDUCER_C_LABEL_TXT[ucLoopCount];
+        break;
+
+    case TRANSDUCER_D_LABEL:
+        for (ucLoopCount = 0x00;
+             ucLoopCount < TRANSDUCER_LABEL_LEN;
+             ucLoopCount++)
+        g_LabelMsg.fields.ucaDescription[ucLoopCount] = TRANSDUCER_D_LABEL_TXT[ucLoopCount];
+        break;
+
+    case TRANSDUCER_E_LABEL:
+        for (ucLoopCount = 0x00;
+             ucLoopCount < TRANSDUCER_LABEL_LEN;
+             ucLoopCount++)
+        g_LabelMsg.fields.ucaDescription[ucLoopCount] = TRANSDUCER_E_LABEL_TXT[ucLoopCount];
+        break;
+
+    case TRANSDUCER_F_LABEL:
+        for (ucLoopCount = 0x00;
+             ucLoopCount < TRANSDUCER_LABEL_LEN;
+             ucLoopCount++)
+        g_LabelMsg.fields.ucaDescription[ucLoopCount] = TRANSDUCER_F_LABEL_TXT[ucLoopCount];
+        break;
+
+    case SP_CORE_VERSION:
+      for (ucLoopCount = 0x00;
+           ucLoopCount < VERSION_LABEL_LEN;
+           ucLoopCount++)
+        g_LabelMsg.fields.ucaDescription[ucLoopCount] = VERSION_LABEL[ucLoopCount];
+      break;
+
+    case WRAPPER_VERSION:
+      for (ucLoopCount = 0x00;
+           ucLoopCount < VERSION_LABEL_LEN;
+           ucLoopCount++)
+        g_LabelMsg.fields.ucaDescription[ucLoopCount] = SOFTWAREVERSION[ucLoopCount];
+          //g_ucaWrapperVersion[ucLoopCount];
+      break;
+    default:
+      for (ucLoopCount = 0x00;
+           ucLoopCount < TRANSDUCER_LABEL_LEN;
+           ucLoopCount++)
+        g_LabelMsg.fields.ucaDescription[ucLoopCount] = "CANNOT COMPUTE!!"[ucLoopCount];
+          //g_ucaTransducerLabels[g_LabelMsg.fields.ucSensorNumber][ucLoopCount];
+        break;
+
+
+  }// END: switch(g_LabelMsg.fields.ucSensorNumber)
+
+  // Send the label message
+  vCOMM_SendLabelMessage(&g_LabelMsg);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Sends the descriptor of this SP Board
+//!
+//! A REPORT_DESCRIPTOR with the capabilities goes out first, then the label
+//! messages for all the transducers and both version strings, back to back.
+//!
+//!   \param none
+//!   \sa msg.h
+///////////////////////////////////////////////////////////////////////////////
+void vCORE_Send_Descriptor(void)
+{
+  uint8 ucSensorNumber;
+  uint16 unCapabilities;
+  uint8 ucReportSize;
+
+  unCapabilities = SP_CAP_BATCH | SP_CAP_COMMAND_REPORT | SP_CAP_TRIGGER;
+#if SP_PACKET_VARIABLE
+  unCapabilities |= SP_CAP_VAR_DATA;
+  ucReportSize = SP_VARDATAMESSAGE_MAX_SIZE;
+#elif SP_PACKET_SIZE_128
+  unCapabilities |= SP_CAP_128BIT_DATA;
+  ucReportSize = SP_128BITDATAMESSAGE_SIZE;
+#else
+  ucReportSize = SP_32BITDATAMESSAGE_SIZE;
+#endif
+#if SP_COMM_FRAMED
+  unCapabilities |= SP_CAP_FRAMED;
+#endif
+#if SP_PACKET_PACKED_5TM
+  unCapabilities |= SP_CAP_PACKED_5TM;
+#endif
+#if SP_COMM_ADDRESSED
+  unCapabilities |= SP_CAP_ADDRESSED;
+#endif
+#if SP_FIRMWARE_UPDATE
+  unCapabilities |= SP_CAP_UPDATE;
+#endif
+#if SP_REPORT_BY_EXCEPTION
+  unCapabilities |= SP_CAP_DEADBAND;
+#endif
+
+  g_p32DataMsg->fields.ucMsgVersion = SP_DATAMESSAGE_VERSION;
+  g_p32DataMsg->fields.ucMsgType = REPORT_DESCRIPTOR;
+  g_p32DataMsg->fields.ucMsgSize = SP_32BITDATAMESSAGE_SIZE;
+  g_p32DataMsg->fields.ucSensorNumber = SP_DESCRIPTOR_LABELS;
+  g_p32DataMsg->fields.ucData1_HI_BYTE = (uint8)(unCapabilities >> 8);
+  g_p32DataMsg->fields.ucData1_LO_BYTE = (uint8)unCapabilities;
+  g_p32DataMsg->fields.ucData2_HI_BYTE = SP_BATCH_MAX_ENTRIES;
+  g_p32DataMsg->fields.ucData2_LO_BYTE = ucReportSize;
+  vCOMM_Send32BitDataMessage(g_p32DataMsg);
+
+  for (ucSensorNumber = 0x00; ucSensorNumber < SP_DESCRIPTOR_LABELS; ucSensorNumber++)
+    vCORE_Send_LabelPKT(ucSensorNumber);
+
+  // Only the last label would be sent again, so a repeat starts over
+  vCOMM_ForgetRequest();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Runs the entries of a BATCH_PKT and sends the REPORT_BATCH
+//!
+//! Each entry is run like a COMMAND_PKT, with its two data words in
+//! g_unaCoreData. The report is built in the RX buffer of the request, over
+//! the entries already run: result n ends before entry n + 1 starts.
+//!
+//!   \param none
+//!   \sa msg.h
+///////////////////////////////////////////////////////////////////////////////
+void vCORE_RunBatch(void)
+{
+	union SP_BatchMessage * p_BatchMsg;
+	union SP_BatchReportMessage * p_BatchReport;
+	struct SP_BatchEntry * p_Entry;
+	uint8 ucEntry;
+	uint8 ucCount;
+	uint8 ucSensor;
+	uint8 ucStatus;
+
+	// The RX buffer holds the whole batch, not just the 32 bit message
+	p_BatchMsg = (union SP_BatchMessage *)g_p32DataMsg;
+	p_BatchReport = (union SP_BatchReportMessage *)g_p32DataMsg;
+
+	ucCount = p_BatchMsg->fields.ucEntryCount;
+	if((ucCount > SP_BATCH_MAX_ENTRIES) ||
+	   (p_BatchMsg->fields.ucMsgSize !=
+	    SP_BATCHMESSAGE_HEADER_SIZE + ucCount * SP_BATCHENTRY_SIZE))
+		ucCount = 0x00;
+
+	for(ucEntry = 0x00; ucEntry < ucCount; ucEntry++)
+	{
+		p_Entry = &p_BatchMsg->fields.Entries[ucEntry];
+		ucSensor = p_Entry->ucSensorNumber;
+
+		g_unaCoreData[0]=
+			(((uint16)p_Entry->ucData1_HI_BYTE) << 8) +
+			((uint16)p_Entry->ucData1_LO_BYTE);
+
+		g_unaCoreData[1]=
+			(((uint16)p_Entry->ucData2_HI_BYTE) << 8) +
+			((uint16)p_Entry->ucData2_LO_BYTE);
+
+		g_unaCoreData[2]= 0;
+		g_unaCoreData[3]= 0;
+		g_unaCoreData[4]= 0;
+		g_unaCoreData[5]= 0;
+		g_unaCoreData[6]= 0;
+		g_unaCoreData[7]= 0;
+
+		ucStatus = SP_BATCH_NO_TRANSDUCER;
+		if((ucSensor < MAX_NUM_TRANSDUCERS) && (gp_tfSensorTable[ucSensor] != NULL))
+		{
+			if((*gp_tfSensorTable[ucSensor])(g_unaCoreData))
+				ucStatus = SP_BATCH_OK;
+			else
+				ucStatus = SP_BATCH_FAILED;
+		}
+
+		p_BatchReport->fields.Results[ucEntry].ucSensorNumber = ucSensor;
+		p_BatchReport->fields.Results[ucEntry].ucStatus = ucStatus;
+	}
+
+	p_BatchReport->fields.ucMsgVersion = SP_DATAMESSAGE_VERSION;
+	p_BatchReport->fields.ucMsgType = REPORT_BATCH;
+	p_BatchReport->fields.ucEntryCount = ucCount;
+	p_BatchReport->fields.ucMsgSize =
+		SP_BATCHMESSAGE_HEADER_SIZE + ucCount * sizeof(struct SP_BatchResult);
+
+	vCOMM_SendBatchReport(p_BatchReport);
+	//UARTDELETE
+	vUARTCOM_TXString("Sent Batch Report\r\n",19);
+}
+
+#if SP_PACKET_VARIABLE
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Sends the transducer data as a variable length report
+//!
+//! Only the words of g_unaCoreData that are not 0 are put in the message,
+//! the CP Board takes the ones left out as 0.
+//!
+//!   \param unTransducerReturn What the transducer function returned, 0
+//!   makes this a REPORT_VAR_ERROR
+//!   \sa msg.h
+///////////////////////////////////////////////////////////////////////////////
+void vCORE_Send_VarReportPKT(uint16 unTransducerReturn)
+{
+	uint8 ucWord;
+	uint8 ucSize;
+
+	g_VarDataMsg.fields.ucMsgVersion = SP_DATAMESSAGE_VERSION;
+	g_VarDataMsg.fields.ucMsgType = REPORT_VAR_DATA;
+	if(!unTransducerReturn)
+		g_VarDataMsg.fields.ucMsgType = REPORT_VAR_ERROR;
+	g_VarDataMsg.fields.ucSensorNumber = g_p32DataMsg->fields.ucSensorNumber;
+	g_VarDataMsg.fields.ucDataMask = 0x00;
+
+	ucSize = 0x00;
+	for(ucWord = 0x00; ucWord < SP_VARDATA_MAX_WORDS; ucWord++)
+	{
+		if(g_unaCoreData[ucWord])
+		{
+			g_VarDataMsg.fields.ucDataMask |= (0x01 << ucWord);
+			g_VarDataMsg.fields.ucaData[ucSize++] = (uint8)(g_unaCoreData[ucWord] >> 8);
+			g_VarDataMsg.fields.ucaData[ucSize++] = (uint8)g_unaCoreData[ucWord];
+		}
+	}
+	g_VarDataMsg.fields.ucMsgSize = SP_VARDATAMESSAGE_HEADER_SIZE + ucSize;
+
+	vCOMM_SendVarDataMessage(&g_VarDataMsg);
+	//UARTDELETE
+	vUARTCOM_TXString("Sent Var Data Message\r\n",23);
+}
+#endif
+
+#if SP_REPORT_BY_EXCEPTION
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Checks whether the transducer data moved out of the deadband
+//!
+//! Compares g_unaCoreData with the last full report of the transducer. If
+//! a word moved by more than the deadband, or there is no last report, the
+//! data becomes the last report. A transducer without a deadband, or one
+//! that failed, always reports in full.
+//!
+//!   \param ucSensorNumber The transducer the report is for
+//!   \param unTransducerReturn What the transducer function returned
+//!   \return TRUE if the full report has to be sent, FALSE if a
+//!   REPORT_NO_CHANGE will do
+//!   \sa SP_REPORT_BY_EXCEPTION
+///////////////////////////////////////////////////////////////////////////////
+uint8 ucCORE_ReportChanged(uint8 ucSensorNumber, uint16 unTransducerReturn)
+{
+	uint16 unDiff;
+	uint8 ucWord;
+	uint8 ucChanged;
+
+	if((ucSensorNumber >= MAX_NUM_TRANSDUCERS) ||
+	   !g_unaCoreDeadband[ucSensorNumber] || !unTransducerReturn)
+		return TRUE;
+
+	ucChanged = !(g_unCoreLastReportValid & ((uint16)0x0001 << ucSensorNumber));
+	for(ucWord = 0x00; (ucWord < 8) && !ucChanged; ucWord++)
+	{
+		unDiff = g_unaCoreData[ucWord] - g_unaCoreLastReport[ucSensorNumber][ucWord];
+		if((int16)unDiff < 0)
+			unDiff = -unDiff;
+		if(unDiff > g_unaCoreDeadband[ucSensorNumber])
+			ucChanged = TRUE;
+	}
+
+	if(ucChanged)
+	{
+		for(ucWord = 0x00; ucWord < 8; ucWord++)
+			g_unaCoreLastReport[ucSensorNumber][ucWord] = g_unaCoreData[ucWord];
+		g_unCoreLastReportValid |= ((uint16)0x0001 << ucSensorNumber);
+	}
+
+	return ucChanged;
+}
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Sends the ID_PKT that identifies this SP Board to the CP Board
+//!
+//!   \param none
+//!   \sa core.h
+///////////////////////////////////////////////////////////////////////////////
+void vCORE_Send_IDPKT(void)
+{
+  g_p32DataMsg->fields.ucMsgVersion = SP_DATAMESSAGE_VERSION; //-scb
+  g_p32DataMsg->fields.ucMsgType = ID_PKT;
+  g_p32DataMsg->fields.ucMsgSize = SP_32BITDATAMESSAGE_SIZE;
+  g_p32DataMsg->fields.ucSensorNumber = ID_PKT_CODE;
+
+  //ID_PKT content to tell CP Board to expect 128 bit data return packets
+  g_p32DataMsg->fields.ucData1_HI_BYTE = ID_PKT_HI_BYTE1;
+  g_p32DataMsg->fields.ucData1_LO_BYTE = ID_PKT_LO_BYTE1;
+  g_p32DataMsg->fields.ucData2_HI_BYTE = ID_PKT_HI_BYTE2;
+  g_p32DataMsg->fields.ucData2_LO_BYTE = ID_PKT_LO_BYTE2;
+
+  if(unCORE_GetVoltage() < MIN_VOLTAGE)
+  {
+	  g_p32DataMsg->fields.ucData2_HI_BYTE = 0xBA;
+	  g_p32DataMsg->fields.ucData2_LO_BYTE = 0xD1;
+  }
+  //Original ID_PKT content
+  //g_p32DataMsg->fields.ucData1_HI_BYTE = 0xAB;
+  //g_p32DataMsg->fields.ucData1_LO_BYTE = 0xCD;
+  //g_p32DataMsg->fields.ucData2_HI_BYTE = 0xEF;
+  //g_p32DataMsg->fields.ucData2_LO_BYTE = 0x12;
+
+
+  // Send the message
+  vCOMM_Send32BitDataMessage(g_p32DataMsg);
+  //UARTDELETE
+  vUARTCOM_TXString("ID_PKT sent.\r\n",14);
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Answers a HAND_SHK from the CP Board
+//!
+//!   \param none
+//!   \sa core.h
+///////////////////////////////////////////////////////////////////////////////
+void vCORE_Send_HandShake(void)
+{
+  g_p32DataMsg->fields.ucMsgVersion = SP_DATAMESSAGE_VERSION; //-scb
+  g_p32DataMsg->fields.ucMsgType = HAND_SHK;
+  g_p32DataMsg->fields.ucMsgSize = SP_32BITDATAMESSAGE_SIZE;
+  g_p32DataMsg->fields.ucSensorNumber = HAND_SHK;
+  g_p32DataMsg->fields.ucData1_HI_BYTE = 0x12;
+  g_p32DataMsg->fields.ucData1_LO_BYTE = 0xEF;
+  g_p32DataMsg->fields.ucData2_HI_BYTE = 0xCD;
+  g_p32DataMsg->fields.ucData2_LO_BYTE = 0xAB;
+  vCOMM_Send32BitDataMessage(g_p32DataMsg);
+  //UARTDELETE
+  vUARTCOM_TXString("HAND_SHK sent\r\n",15);
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Handles a BAUD_CHANGE from the CP Board
+//!
+//! The answer goes out at the old rate, then the link switches to the new
+//! rate and waits for a HAND_SHK from the CP Board. The new rate is only
+//! provisional until the next good frame after the answer to the HAND_SHK
+//! comes in at it, as the CP Board goes back to the old rate if it does not
+//! get that answer. If either frame does not come in time the link goes back
+//! to the old rate, so a failed change never leaves the two boards talking
+//! at different rates. The second frame is left for vCORE_Run() to handle.
+//!
+//!   \param none
+//!   \sa msg.h, vCOMM_SetBaud()
+///////////////////////////////////////////////////////////////////////////////
+void vCORE_ChangeBaud(void)
+{
+  uint16 unRate;
+  uint16 unNewBaud;
+  uint16 unOldBaud;
+
+  unRate = ((uint16)g_p32DataMsg->fields.ucData1_HI_BYTE << 8) |
+           g_p32DataMsg->fields.ucData1_LO_BYTE;
+  unNewBaud = unCOMM_BaudForRate(unRate);
+
+  // Echo the rate if it is supported, refuse it with 0 if it is not
+  g_p32DataMsg->fields.ucMsgVersion = SP_DATAMESSAGE_VERSION;
+  g_p32DataMsg->fields.ucMsgType = BAUD_CHANGE;
+  g_p32DataMsg->fields.ucMsgSize = SP_32BITDATAMESSAGE_SIZE;
+  g_p32DataMsg->fields.ucSensorNumber = BAUD_CHANGE;
+  if (unNewBaud == 0x0000)
+  {
+    g_p32DataMsg->fields.ucData1_HI_BYTE = 0x00;
+    g_p32DataMsg->fields.ucData1_LO_BYTE = 0x00;
+  }
+  g_p32DataMsg->fields.ucData2_HI_BYTE = 0x00;
+  g_p32DataMsg->fields.ucData2_LO_BYTE = 0x00;
+  vCOMM_Send32BitDataMessage(g_p32DataMsg);
+
+  if (unNewBaud == 0x0000)
+  {
+    //UARTDELETE
+    vUARTCOM_TXString("BAUD_CHANGE refused\r\n",21);
+    return;
+  }
+
+  // The answer has to leave at the old rate before switching
+  vCOMM_WaitForTXComplete();
+  unOldBaud = unCOMM_GetBaud();
+  vCOMM_SetBaud(unNewBaud);
+
+  // Changing the rate dropped the BAUD_CHANGE buffer, any other request in
+  // place of the HAND_SHK is released by vCORE_Run()
+  g_p32DataMsg = &g_32DataMsg;
+  if ((ucCOMM_WaitFor32BitDataMessageTimeout(COMM_BAUD_VERIFY_OVERFLOWS) == COMM_OK) &&
+      ((g_p32DataMsg = p_COMM_Take32BitDataMessage())->fields.ucMsgType == HAND_SHK))
+  {
+    // Take the SEQ of the HAND_SHK, so the answer carries it and a repeat
+    // of it is answered from the cache
+    (void)ucCOMM_IsRepeatedRequest();
+    vCORE_Send_HandShake();
+    vCOMM_ReleaseMessage();
+    g_p32DataMsg = &g_32DataMsg;
+
+    // Still provisional, a good frame at the new rate shows the CP Board got
+    // the answer and stayed. A repeat of the HAND_SHK counts too.
+    if (ucCOMM_WaitFor32BitDataMessageTimeout(COMM_BAUD_VERIFY_OVERFLOWS) == COMM_OK)
+    {
+      //UARTDELETE
+      vUARTCOM_TXString("BAUD_CHANGE done\r\n",18);
+      return;
+    }
+  }
+
+  vCOMM_SetBaud(unOldBaud);
+  //UARTDELETE
+  vUARTCOM_TXString("BAUD_CHANGE failed\r\n",20);
+}
+
+
+//******************  Message Handlers  *************************************//
+//! @name Message Handlers
+//! These functions handle one message type each. The message is in
+//! g_p32DataMsg, in its RX message buffer, and the reply is built in place.
+//! They are registered in gp_mhMessageTable.
+//! @{
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Handles COMMAND_PKT, COMMAND_REPORT_PKT and TRIGGER_PKT
+//!
+//! Runs the transducer function with the two data words of the message.
+//! A COMMAND_PKT is confirmed first, after a COMMAND_REPORT_PKT the report
+//! is sent right away and a TRIGGER_PKT gets no answer at all.
+//!   \param None
+//!   \return None
+///////////////////////////////////////////////////////////////////////////////
+void vCORE_Handle_Command(void)
+{
+	uint8 ucSensor;
+
+	//UARTDELETE
+	vUARTCOM_TXString("COMMAND_PKT Received\r\n",22);
+	g_unCoreTransducerReturn = 0; //default return value to 0
+	ucSensor = g_p32DataMsg->fields.ucSensorNumber;
+
+	// With COMMAND_REPORT_PKT the report is the confirmation, a
+	// TRIGGER_PKT gets no answer at all
+	if((ucSensor < MAX_NUM_TRANSDUCERS) && (gp_tfSensorTable[ucSensor] != NULL) &&
+	   (g_p32DataMsg->fields.ucMsgType == COMMAND_PKT))
+		vCORE_Send_ConfirmPKT();
+
+	g_unaCoreData[0]=
+		(((uint16)g_p32DataMsg->fields.ucData1_HI_BYTE) << 8) +
+		((uint16)g_p32DataMsg->fields.ucData1_LO_BYTE);
+
+	g_unaCoreData[1]=
+		(((uint16)g_p32DataMsg->fields.ucData2_HI_BYTE) << 8) +
+		((uint16)g_p32DataMsg->fields.ucData2_LO_BYTE);
+
+	g_unaCoreData[2]= 0;
+	g_unaCoreData[3]= 0;
+	g_unaCoreData[4]= 0;
+	g_unaCoreData[5]= 0;
+	g_unaCoreData[6]= 0;
+	g_unaCoreData[7]= 0;
+
+	// The transducer may sleep in LPM3, let the confirm finish first
+	vCOMM_WaitForTXComplete();
+
+	// A broadcast TRIGGER_PKT reaches boards that may not have this
+	// transducer, which then report an error when asked
+	if((ucSensor < MAX_NUM_TRANSDUCERS) && (gp_tfSensorTable[ucSensor] != NULL))
+		g_unCoreTransducerReturn = //if everything went ok, g_unCoreTransducerReturn > 0;
+			(*gp_tfSensorTable[ucSensor])(g_unaCoreData); //pass on g_unaCoreData.
+
+	// After a COMMAND_REPORT_PKT the CP Board is waiting for the report,
+	// after a COMMAND_PKT or TRIGGER_PKT it sends a REQUEST_DATA for it
+	if(g_p32DataMsg->fields.ucMsgType == COMMAND_REPORT_PKT)
+		vCORE_Handle_RequestData();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Handles REQUEST_DATA, sends the report of the last transducer run
+//!   \param None
+//!   \return None
+///////////////////////////////////////////////////////////////////////////////
+void vCORE_Handle_RequestData(void)
+{
+#if SP_REPORT_BY_EXCEPTION
+	// Within the deadband the CP Board already has the reading
+	if(!ucCORE_ReportChanged(g_p32DataMsg->fields.ucSensorNumber, g_unCoreTransducerReturn))
+	{
+		vCOMM_SendNoChange(g_p32DataMsg->fields.ucSensorNumber);
+		return;
+	}
+#endif
+
+#if SP_PACKET_VARIABLE
+	vCORE_Send_VarReportPKT(g_unCoreTransducerReturn);
+#elif SP_PACKET_SIZE_128
+	// Now send message back to CP Board
+	g_128DataMsg.fields.ucMsgVersion = SP_DATAMESSAGE_VERSION;
+	g_128DataMsg.fields.ucMsgType = REPORT_DATA;
+	g_128DataMsg.fields.ucMsgSize = SP_128BITDATAMESSAGE_SIZE;
+	g_128DataMsg.fields.ucSensorNumber = g_p32DataMsg->fields.ucSensorNumber;
+
+	//g_unCoreTransducerReturn is an 'OK' message.
+	//If not >0, then send error message in code
+	if(!g_unCoreTransducerReturn){
+		g_128DataMsg.fields.ucMsgType = REPORT_ERROR;
+	}
+	//collect data from g_unaCoreData
+
+	g_128DataMsg.fields.ucData1_HI_BYTE = (uint8)(g_unaCoreData[0] >> 8);
+	g_128DataMsg.fields.ucData1_LO_BYTE = (uint8)g_unaCoreData[0];
+	g_128DataMsg.fields.ucData2_HI_BYTE = (uint8)(g_unaCoreData[1] >> 8);
+	g_128DataMsg.fields.ucData2_LO_BYTE = (uint8)g_unaCoreData[1];
+	g_128DataMsg.fields.ucData3_HI_BYTE = (uint8)(g_unaCoreData[2] >> 8);
+	g_128DataMsg.fields.ucData3_LO_BYTE = (uint8)g_unaCoreData[2];
+	g_128DataMsg.fields.ucData4_HI_BYTE = (uint8)(g_unaCoreData[3] >> 8);
+	g_128DataMsg.fields.ucData4_LO_BYTE = (uint8)g_unaCoreData[3];
+	g_128DataMsg.fields.ucData5_HI_BYTE = (uint8)(g_unaCoreData[4] >> 8);
+	g_128DataMsg.fields.ucData5_LO_BYTE = (uint8)g_unaCoreData[4];
+	g_128DataMsg.fields.ucData6_HI_BYTE = (uint8)(g_unaCoreData[5] >> 8);
+	g_128DataMsg.fields.ucData6_LO_BYTE = (uint8)g_unaCoreData[5];
+	g_128DataMsg.fields.ucData7_HI_BYTE = (uint8)(g_unaCoreData[6] >> 8);
+	g_128DataMsg.fields.ucData7_LO_BYTE = (uint8)g_unaCoreData[6];
+	g_128DataMsg.fields.ucData8_HI_BYTE = (uint8)(g_unaCoreData[7] >> 8);
+	g_128DataMsg.fields.ucData8_LO_BYTE = (uint8)g_unaCoreData[7];
+	// Send the message
+	vCOMM_Send128BitDataMessage(&g_128DataMsg);
+	//UARTDELETE
+	vUARTCOM_TXString("Sent Return Message\r\n",21);
+#else
+	// Now send message back to CP Board
+	g_p32DataMsg->fields.ucMsgVersion = SP_DATAMESSAGE_VERSION;
+	g_p32DataMsg->fields.ucMsgType = REPORT_DATA;
+	g_p32DataMsg->fields.ucMsgSize = SP_32BITDATAMESSAGE_SIZE;
+
+	//g_unCoreTransducerReturn is an 'OK' message.
+	//If not >0, then send error message in code
+	if(g_unCoreTransducerReturn){
+	//collect data from g_unaCoreData
+		g_p32DataMsg->fields.ucData1_HI_BYTE = (uint8)(g_unaCoreData[0] >> 8);
+		g_p32DataMsg->fields.ucData1_LO_BYTE = (uint8)g_unaCoreData[0];
+		g_p32DataMsg->fields.ucData2_HI_BYTE = (uint8)(g_unaCoreData[1] >> 8);
+		g_p32DataMsg->fields.ucData2_LO_BYTE = (uint8)g_unaCoreData[1];
+	}
+	else
+	{//This is my ERRORMSG (EBB0B356) for now :P
+		g_p32DataMsg->fields.ucData1_HI_BYTE = 0xEB;
+		g_p32DataMsg->fields.ucData1_LO_BYTE = 0xB0;
+		g_p32DataMsg->fields.ucData2_HI_BYTE = 0xB3;
+		g_p32DataMsg->fields.ucData2_LO_BYTE = 0x56;
+	}
+	// Send the message
+	vCOMM_Send32BitDataMessage(g_p32DataMsg);
+	//UARTDELETE
+	vUARTCOM_TXString("Sent Data Message\r\n",19);
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Handles REQUEST_LABEL
+//!   \param None
+//!   \return None
+///////////////////////////////////////////////////////////////////////////////
+void vCORE_Handle_RequestLabel(void)
+{
+	vCORE_Send_LabelPKT(g_p32DataMsg->fields.ucSensorNumber);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Handles REQUEST_DESCRIPTOR
+//!   \param None
+//!   \return None
+///////////////////////////////////////////////////////////////////////////////
+void vCORE_Handle_RequestDescriptor(void)
+{
+	//UARTDELETE
+	vUARTCOM_TXString("REQUEST_DESCRIPTOR Received\r\n",29);
+	vCORE_Send_Descriptor();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Handles HAND_SHK
+//!
+//! The first HAND_SHK is answered with the ID_PKT if it has not been sent
+//! yet, the others with a HAND_SHK.
+//!   \param None
+//!   \return None
+///////////////////////////////////////////////////////////////////////////////
+void vCORE_Handle_HandShake(void)
+{
+	//UARTDELETE
+	vUARTCOM_TXString("HAND_SHK Received\r\n",19);
+	if(!g_ucCoreIDPKTSent)
+	{
+		vCORE_Send_IDPKT();
+		g_ucCoreIDPKTSent = TRUE;
+		return;
+	}
+	vCORE_Send_HandShake();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Handles BAUD_CHANGE
+//!   \param None
+//!   \return None
+///////////////////////////////////////////////////////////////////////////////
+void vCORE_Handle_BaudChange(void)
+{
+	//UARTDELETE
+	vUARTCOM_TXString("BAUD_CHANGE Received\r\n",22);
+	vCORE_ChangeBaud();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Handles NAK_PKT, the CP Board did not get our last message
+//!   \param None
+//!   \return None
+///////////////////////////////////////////////////////////////////////////////
+void vCORE_Handle_NAK(void)
+{
+	vCOMM_ResendLastMessage();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Handles REQUEST_LINK_STATUS
+//!   \param None
+//!   \return None
+///////////////////////////////////////////////////////////////////////////////
+void vCORE_Handle_RequestLinkStatus(void)
+{
+	//UARTDELETE
+	vUARTCOM_TXString("REQUEST_LINK_STATUS Received\r\n",30);
+	vCOMM_SendLinkStatus(g_p32DataMsg->fields.ucData1_HI_BYTE |
+	                     g_p32DataMsg->fields.ucData1_LO_BYTE);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Handles BATCH_PKT
+//!   \param None
+//!   \return None
+///////////////////////////////////////////////////////////////////////////////
+void vCORE_Handle_Batch(void)
+{
+	//UARTDELETE
+	vUARTCOM_TXString("BATCH_PKT Received\r\n",20);
+	vCORE_RunBatch();
+}
+
+#if SP_REPORT_BY_EXCEPTION
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Handles SET_DEADBAND_PKT
+//!   \param None
+//!   \return None
+///////////////////////////////////////////////////////////////////////////////
+void vCORE_Handle_SetDeadband(void)
+{
+	if(g_p32DataMsg->fields.ucSensorNumber < MAX_NUM_TRANSDUCERS)
+	{
+		g_unaCoreDeadband[g_p32DataMsg->fields.ucSensorNumber] =
+			(((uint16)g_p32DataMsg->fields.ucData1_HI_BYTE) << 8) +
+			((uint16)g_p32DataMsg->fields.ucData1_LO_BYTE);
+		// The next report goes out in full
+		g_unCoreLastReportValid &=
+			~((uint16)0x0001 << g_p32DataMsg->fields.ucSensorNumber);
+	}
+	vCORE_Send_ConfirmPKT();
+}
+#endif
+
+#if SP_FIRMWARE_UPDATE
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Handles UPDATE_START_PKT, does not return
+//!   \param None
+//!   \return None, the board restarts into the new image
+///////////////////////////////////////////////////////////////////////////////
+void vCORE_Handle_UpdateStart(void)
+{
+	//UARTDELETE
+	vUARTCOM_TXString("UPDATE_START_PKT Received\r\n",27);
+	vBOOT_Run(g_p32DataMsg);
+}
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief Handles the message types with no handler
+//!
+//! Answers with a REPORT_ERROR carrying PACKET_ERROR_CODE.
+//!   \param None
+//!   \return None
+///////////////////////////////////////////////////////////////////////////////
+void vCORE_Handle_Unknown(void)
+{
+	vUARTCOM_TXString("Unknown Message\r\n",17);
+	vUARTCOM_TXString("Message Version: ",17);
+	vUARTCOM_TXString((char*)(g_p32DataMsg->fields.ucMsgVersion+32),1);
+	vUARTCOM_TXString("\r\nMessage Type: ",16);
+	vUARTCOM_TXString((char*)(g_p32DataMsg->fields.ucMsgType+32),1);
+	vUARTCOM_TXString("\r\nMessage Size: ",16);
+	vUARTCOM_TXString((char*)(g_p32DataMsg->fields.ucMsgSize+32),1);
+	vUARTCOM_TXString("\r\nSensor Number: ",17);
+	vUARTCOM_TXString((char*)(g_p32DataMsg->fields.ucSensorNumber+32),1);
+	vUARTCOM_TXString("\r\nFirst Byte: ",14);
+	vUARTCOM_TXString((char*)(g_p32DataMsg->fields.ucData1_HI_BYTE+32),1);
+	vUARTCOM_TXString("\r\n",2);
+
+	g_p32DataMsg->fields.ucMsgVersion = SP_DATAMESSAGE_VERSION; //-scb
+	g_p32DataMsg->fields.ucMsgType = REPORT_ERROR;
+	g_p32DataMsg->fields.ucMsgSize = SP_32BITDATAMESSAGE_SIZE;
+	g_p32DataMsg->fields.ucSensorNumber = ID_PKT_CODE;
+
+	//ID_PKT content to tell CP Board to expect 128 bit data return packets
+	g_p32DataMsg->fields.ucData1_HI_BYTE = PACKET_ERROR_CODE;
+	vCOMM_Send32BitDataMessage(g_p32DataMsg);
+}
+//! @}
+
+//******************  Message Handler Table  ********************************//
+//! @name Message Handler Table
+//! @{
+#if SP_FIRMWARE_UPDATE
+#define CORE_UPDATE_START_HANDLER   vCORE_Handle_UpdateStart
+#else
+#define CORE_UPDATE_START_HANDLER   NULL
+#endif
+#if SP_REPORT_BY_EXCEPTION
+#define CORE_SET_DEADBAND_HANDLER   vCORE_Handle_SetDeadband
+#else
+#define CORE_SET_DEADBAND_HANDLER   NULL
+#endif
+
+//! \def CORE_MESSAGE_LIST
+//! \brief The handler of each message type, in the order of the types
+//!
+//! There is one CORE_HANDLER() line for every type from 0x00 up. Types the
+//! SP Board only sends are CORE_NO_HANDLER(). The list is expanded three
+//! times: into an enum that numbers the lines, into a check that the number
+//! of every line is its type, and into gp_mhMessageTable. To add a message
+//! type, define it in msg.h, add its line at the end and move
+//! CORE_MESSAGE_TYPES to it.
+#define CORE_MESSAGE_LIST \
+	CORE_HANDLER(HAND_SHK,            vCORE_Handle_HandShake) \
+	CORE_NO_HANDLER(ID_PKT) \
+	CORE_HANDLER(REQUEST_DATA,        vCORE_Handle_RequestData) \
+	CORE_NO_HANDLER(REPORT_DATA) \
+	CORE_HANDLER(REQUEST_LABEL,       vCORE_Handle_RequestLabel) \
+	CORE_HANDLER(COMMAND_PKT,         vCORE_Handle_Command) \
+	CORE_NO_HANDLER(CONFIRM_COMMAND) \
+	CORE_NO_HANDLER(REPORT_ERROR) \
+	CORE_HANDLER(NAK_PKT,             vCORE_Handle_NAK) \
+	CORE_HANDLER(BAUD_CHANGE,         vCORE_Handle_BaudChange) \
+	CORE_HANDLER(REQUEST_LINK_STATUS, vCORE_Handle_RequestLinkStatus) \
+	CORE_NO_HANDLER(REPORT_LINK_STATUS) \
+	CORE_NO_HANDLER(REPORT_VAR_DATA) \
+	CORE_NO_HANDLER(REPORT_VAR_ERROR) \
+	CORE_HANDLER(COMMAND_REPORT_PKT,  vCORE_Handle_Command) \
+	CORE_HANDLER(BATCH_PKT,           vCORE_Handle_Batch) \
+	CORE_NO_HANDLER(REPORT_BATCH) \
+	CORE_HANDLER(REQUEST_DESCRIPTOR,  vCORE_Handle_RequestDescriptor) \
+	CORE_NO_HANDLER(REPORT_DESCRIPTOR) \
+	CORE_HANDLER(TRIGGER_PKT,         vCORE_Handle_Command) \
+	CORE_HANDLER(UPDATE_START_PKT,    CORE_UPDATE_START_HANDLER) \
+	CORE_NO_HANDLER(UPDATE_DATA_PKT) \
+	CORE_NO_HANDLER(UPDATE_WRITE_PKT) \
+	CORE_NO_HANDLER(UPDATE_FINISH_PKT) \
+	CORE_NO_HANDLER(UPDATE_ACK) \
+	CORE_HANDLER(SET_DEADBAND_PKT,    CORE_SET_DEADBAND_HANDLER) \
+	CORE_NO_HANDLER(REPORT_NO_CHANGE)
+
+// Number the lines of the list
+#define CORE_HANDLER(ucType, p_mhHandler)  CORE_LINE_##ucType,
+#define CORE_NO_HANDLER(ucType)            CORE_LINE_##ucType,
+enum CORE_MessageLines { CORE_MESSAGE_LIST CORE_MESSAGE_LINES };
+#undef CORE_HANDLER
+#undef CORE_NO_HANDLER
+
+// A line out of order, missing or added does not compile
+#define CORE_HANDLER(ucType, p_mhHandler) \
+	typedef char CORE_Check_##ucType[(CORE_LINE_##ucType == (ucType)) ? 1 : -1];
+#define CORE_NO_HANDLER(ucType) \
+	typedef char CORE_Check_##ucType[(CORE_LINE_##ucType == (ucType)) ? 1 : -1];
+CORE_MESSAGE_LIST
+typedef char CORE_MessageTableCheck[(CORE_MESSAGE_LINES == CORE_MESSAGE_TYPES) ? 1 : -1];
+#undef CORE_HANDLER
+#undef CORE_NO_HANDLER
+
+//! \var const p_MessageHandler gp_mhMessageTable[CORE_MESSAGE_TYPES]
+//! \brief The handler of each message type, indexed by the type
+//!
+//! Built from CORE_MESSAGE_LIST. Types the SP Board only sends, and those
+//! switched off, are NULL. The table is in flash, so a lookup costs the
+//! same for every type.
+#define CORE_HANDLER(ucType, p_mhHandler)  (p_mhHandler),
+#define CORE_NO_HANDLER(ucType)            NULL,
+const p_MessageHandler gp_mhMessageTable[CORE_MESSAGE_TYPES] =
+{
+	CORE_MESSAGE_LIST
+};
+#undef CORE_HANDLER
+#undef CORE_NO_HANDLER
+//! @}
+
+///////////////////////////////////////////////////////////////////////////////
+//! \brief This functions runs the core
+//!
+//! This function runs the core. This function does not return, so all of the
+//! core setup and init must be done before the call to this function. The
+//! function waits for a data packet from the CP Board, then looks up the
+//! handler of its type in gp_mhMessageTable. A response packet is then sent
+//! and the core waits for the next data packet.
+//!   \param None.
+//!   \return NEVER. This function never returns
+//!   \sa msg.h
+///////////////////////////////////////////////////////////////////////////////
+void vCORE_Run(void)
+{
+  uint8 ucMsgType;
+
+  g_p32DataMsg = &g_32DataMsg;
+  g_unCoreTransducerReturn = 0;
+
+#if SP_COMM_AUTOBAUD || SP_COMM_ADDRESSED
+  // The CP Board talks first, so the baud rate can be measured or so the SP
+  // Boards on a shared line do not all answer at once. The ID_PKT is the
+  // answer to its first HAND_SHK.
+  g_ucCoreIDPKTSent = FALSE;
+#else
+  // First, tell the CP Board that we are ready for commands
+  vCORE_Send_IDPKT();
+  g_ucCoreIDPKTSent = TRUE;
+#endif
+
+  // The primary execution loop
+  while(TRUE)
+  {
+    vCOMM_WaitFor32BitDataMessage();//Wait to receive 64 bits (32 bit header, 32 bit data)
+    // Work on the request where it was received, the RX ISR can take the
+    // next one into the other buffer in the meantime
+    g_p32DataMsg = p_COMM_Take32BitDataMessage();
+    //UARTDELETE
+    vUARTCOM_TXString("Got Message from CP.\r\n",22);
+
+    // The CP Board did not get the reply to this request, send it again
+    // instead of running the transducer again
+    if (ucCOMM_IsRepeatedRequest())
+      vCOMM_ResendLastMessage();
+    else
+    {
+      ucMsgType = g_p32DataMsg->fields.ucMsgType;
+      if((ucMsgType < CORE_MESSAGE_TYPES) && (gp_mhMessageTable[ucMsgType] != NULL))
+        (*gp_mhMessageTable[ucMsgType])();
+      else
+        vCORE_Handle_Unknown();
+    }
+
+    // Hand the request buffer back to the RX ISR
+    if (g_p32DataMsg != &g_32DataMsg)
+      vCOMM_ReleaseMessage();
+    g_p32DataMsg = &g_32DataMsg;
+
+    // The reply is still going out on TimerA, which stops in LPM3
+    vCOMM_WaitForTXComplete();
+    // The port interrupt can only wake us if nothing from the CP Board is
+    // still waiting in the RX buffers
+    __bic_SR_register(GIE);
+    if (!ucCOMM_RXPending())
+    {
+#if SP_IDLE_LPM4
+      // Nothing is running off the ACLK, so stop it too. The CP Board sends
+      // SP_WAKE_BYTE first to cover the time the DCO takes to start
+      if (!(TBCTL & (MC0 | MC1)))
+        __bis_SR_register(GIE + LPM4_bits);
+      else
+#endif
+      __bis_SR_register(GIE + LPM3_bits);//LPM4 works too, but then no timers whatsoever. We did not want to limit the Applications that much.
+    }
+    __bis_SR_register(GIE);
+    // After Tranceiver code has been executed, wait until you receive the
+    // REQUEST_DATA packet and then send the packet. You can then go into
+    // sleep mode again. It is expected that the SP will be turned off by
+    // the CP. If not, in LPM3 it is still ready to receive messages.
+  }// END: while(TRUE)
+}
+
+//! @}
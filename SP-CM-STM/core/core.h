@@ -1,111 +1,145 @@
-///////////////////////////////////////////////////////////////////////////////
-//! \file core.h
-//! \brief Header file for the \ref core Module.
-//!
-//! This file provides all of the defines and function prototypes for the
-//! \ref core Module.
-//!
-//! @addtogroup core Core
-//! The Core Module handles all of the communication to the CP board as well
-//! as acts as the supervisor to all activities on the SP Board. The user
-//! built wrapper should interface with the Core Module as documented.
-//! @{
-///////////////////////////////////////////////////////////////////////////////
-//*****************************************************************************
-// By: Kenji Yamamoto
-//     Wireless Networks Research Lab
-//     Dept of Electrical Engineering, CEFNS
-//     Northern Arizona University
-//
-//*****************************************************************************
-
-#ifndef CORE_H_
-  #define CORE_H_
-
-  //! @name System Defines
-  //! These defines are used by the entire system
-  //! @{
-  #define TRUE  1
-  #define FALSE 0
-
-  #define true  1
-  #define false 0
-
-  #define NULL 0
-
-  // Maximum number of transducers
-  //! \def MAX_NUM_TRANSDUCERS
-  //! \brief This sets the maximum number of transducers the core can handle
-  #define MAX_NUM_TRANSDUCERS 0x10
-
-  //! \def TRANSDUCER_LABEL_LEN
-  //! \brief The fixed length of the transducer labels
-  #define TRANSDUCER_LABEL_LEN 0x10
-
-  //! \def VERSION_LABEL_LEN
-  //! \brief The fixed length of the version labels
-  #define VERSION_LABEL_LEN    0x10
-
-  //! \def ID_PKT_CODE
-  //! \brief The ID_PKT code used to confirm that the transmission is flawless.
-  //! The code is 0xB7 or 10110111
-  #define ID_PKT_CODE	       0xB7 
-
-  //! \def MIN_VOLTAGE
-  //! \brief When checking the voltage, it should be at least 2.2V or we send an error
-  //! The value is 2.2V
-  #define MIN_VOLTAGE	       0xDC
-
-  //! \def PACKET_ERROR_CODE
-  //! \brief This error code is sent to the CP if the packet type is not recognized
-  #define PACKET_ERROR_CODE	   0xF1
-
-  //! @}
-
-  // Size typedefs
-  //! @name System Typedefs
-  //! These typedefs are used for the entire core and wrapper. This makes
-  //! porting code easier and variable types faster to write.
-  //! @{
-  typedef unsigned char uint8;
-  typedef signed   char int8;
-
-  typedef unsigned int  uint16;
-  typedef signed   int  int16;
-
-  typedef unsigned long uint32;
-  typedef signed   long int32;
-
-
-  // Typedef of the sensor measurement function
-  //! This is the function prototype that all transducer functions must follow
-  typedef uint16 (*p_TransducerFunction)(uint16 *);
-  //! @}
-
-  unsigned int uiCORE_GetVoltage(void);
-
-  //! @name Control Functions
-  //! These functions are used to control the \ref core Module.
-  //! @{
-  void vCORE_Initilize(void);
-  void vCORE_InitilizeTransducerTable(void); //Now also sets functions from header
-  void vCORE_Run(void);
-  //! @}
-
-  //! @name Interface Functions
-  //! These functions are used to interface with the \ref core Module.
-  //! @{
-  //void vCORE_SetTransducerLabel(uint8 ucTransducerNumber, uint8 * p_ucaLabel); //Not needed anymore
-  //void vCORE_SetWrapperSoftwareString(uint8 * p_ucVersion); //Not needed anymore
-  //void vCORE_AssignFunctionToTransducer(uint8 ucNumber, p_TransducerFunction p_tfFunction); //Not needed anymore
-  //! @}
-
-
-  // Core modules to include
-  #include "comm/msg.h"
-  #include "comm/comm.h"
-  #include "changeable_core_header.h"
-
-
-#endif /*CORE_H_*/
-//! @}
+///////////////////////////////////////////////////////////////////////////////
+//! \file core.h
+//! \brief Header file for the \ref core Module.
+//!
+//! This file provides all of the defines and function prototypes for the
+//! \ref core Module.
+//!
+//! @addtogroup core Core
+//! The Core Module handles all of the communication to the CP board as well
+//! as acts as the supervisor to all activities on the SP Board. The user
+//! built wrapper should interface with the Core Module as documented.
+//! @{
+///////////////////////////////////////////////////////////////////////////////
+//*****************************************************************************
+// By: Kenji Yamamoto
+//     Wireless Networks Research Lab
+//     Dept of Electrical Engineering, CEFNS
+//     Northern Arizona University
+//
+//*****************************************************************************
+
+#ifndef CORE_H_
+  #define CORE_H_
+
+  //! @name System Defines
+  //! These defines are used by the entire system
+  //! @{
+  #define TRUE  1
+  #define FALSE 0
+
+  #define true  1
+  #define false 0
+
+  #define NULL 0
+
+  // Maximum number of transducers
+  //! \def MAX_NUM_TRANSDUCERS
+  //! \brief This sets the maximum number of transducers the core can handle
+  #define MAX_NUM_TRANSDUCERS 0x10
+
+  //! \def TRANSDUCER_LABEL_LEN
+  //! \brief The fixed length of the transducer labels
+  #define TRANSDUCER_LABEL_LEN 0x10
+
+  //! \def VERSION_LABEL_LEN
+  //! \brief The fixed length of the version labels
+  #define VERSION_LABEL_LEN    0x10
+
+  //! \def ID_PKT_CODE
+  //! \brief The ID_PKT code used to confirm that the transmission is flawless.
+  //! The code is 0xB7 or 10110111
+  #define ID_PKT_CODE	       0xB7 
+
+  //! \def MIN_VOLTAGE
+  //! \brief When checking the voltage, it should be at least 2.2V or we send an error
+  //! The value is 2.2V
+  #define MIN_VOLTAGE	       0xDC
+
+  //! \def PACKET_ERROR_CODE
+  //! \brief This error code is sent to the CP if the packet type is not recognized
+  #define PACKET_ERROR_CODE	   0xF1
+
+  //! \def CORE_SMCLK_HZ
+  //! \brief The SMCLK frequency set up by vCORE_Initilize()
+  #define CORE_SMCLK_HZ        (SP_SMCLK_16MHZ ? 16000000UL : 4000000UL)
+
+  //! @}
+
+  // Size typedefs
+  //! @name System Typedefs
+  //! These typedefs are used for the entire core and wrapper. This makes
+  //! porting code easier and variable types faster to write.
+  //! @{
+  typedef unsigned char uint8;
+  typedef signed   char int8;
+
+  typedef unsigned int  uint16;
+  typedef signed   int  int16;
+
+  typedef unsigned long uint32;
+  typedef signed   long int32;
+
+
+  // Typedef of the sensor measurement function
+  //! This is the function prototype that all transducer functions must follow
+  typedef uint16 (*p_TransducerFunction)(uint16 *);
+
+  // Typedef of the message handler function
+  //! This is the function prototype of the handlers in gp_mhMessageTable
+  typedef void (*p_MessageHandler)(void);
+  //! @}
+
+  //! @name Message Handler Table
+  //! The size of gp_mhMessageTable, see CORE_MESSAGE_LIST in core.c.
+  //! @{
+  //! \def CORE_MESSAGE_TYPES
+  //! \brief The number of message types, REPORT_NO_CHANGE is the last one
+  #define CORE_MESSAGE_TYPES   (REPORT_NO_CHANGE + 1)
+  //! @}
+
+  unsigned int uiCORE_GetVoltage(void);
+
+  //! @name Control Functions
+  //! These functions are used to control the \ref core Module.
+  //! @{
+  void vCORE_Initilize(void);
+  void vCORE_InitilizeTransducerTable(void); //Now also sets functions from header
+  void vCORE_Run(void);
+  //! @}
+
+  //! @name Message Handlers
+  //! These functions each handle one message type in vCORE_Run().
+  //! @{
+  void vCORE_Handle_Command(void);
+  void vCORE_Handle_RequestData(void);
+  void vCORE_Handle_RequestLabel(void);
+  void vCORE_Handle_RequestDescriptor(void);
+  void vCORE_Handle_HandShake(void);
+  void vCORE_Handle_BaudChange(void);
+  void vCORE_Handle_NAK(void);
+  void vCORE_Handle_RequestLinkStatus(void);
+  void vCORE_Handle_Batch(void);
+  void vCORE_Handle_SetDeadband(void);
+  void vCORE_Handle_UpdateStart(void);
+  void vCORE_Handle_Unknown(void);
+  //! @}
+
+  //! @name Interface Functions
+  //! These functions are used to interface with the \ref core Module.
+  //! @{
+  //void vCORE_SetTransducerLabel(uint8 ucTransducerNumber, uint8 * p_ucaLabel); //Not needed anymore
+  //void vCORE_SetWrapperSoftwareString(uint8 * p_ucVersion); //Not needed anymore
+  //void vCORE_AssignFunctionToTransducer(uint8 ucNumber, p_TransducerFunction p_tfFunction); //Not needed anymore
+  //! @}
+
+
+  // Core modules to include
+  #include "comm/msg.h"
+  #include "comm/comm.h"
+  #include "changeable_core_header.h"
+  #include "boot/boot.h"
+
+
+#endif /*CORE_H_*/
+//! @}
@@ -0,0 +1,103 @@
+/******************************************************************************/
+/* lnk_msp430f235_app.cmd - LINKER COMMAND FILE FOR THE APPLICATION OF        */
+/*                          MSP430F235 PROGRAMS WITH SP_FIRMWARE_UPDATE SET   */
+/*                          TO 1                                              */
+/*                                                                            */
+/*   Links every source but boot.c and comm.c. This is the image a firmware   */
+/*   update sends. It calls the BOOT area, linked with                        */
+/*   lnk_msp430f235_boot.cmd, through the jump table at its start and keeps   */
+/*   out of the BOOT RAM and the BOOT flash.                                  */
+/*                                                                            */
+/*   Usage:  lnk430 <obj files...>    -o <out file> -m <map file> lnk.cmd     */
+/*           cl430  <src files...> -z -o <out file> -m <map file> lnk.cmd     */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/* These linker options are for command line linking only.  For IDE linking,  */
+/* you should set your linker options in Project Properties                   */
+/* -c                                               LINK USING C CONVENTIONS  */
+/* -stack  0x0100                                   SOFTWARE STACK SIZE       */
+/* -heap   0x0100                                   HEAP AREA SIZE            */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+
+/****************************************************************************/
+/* SPECIFY THE SYSTEM MEMORY MAP                                            */
+/****************************************************************************/
+
+MEMORY
+{
+    SFR                     : origin = 0x0000, length = 0x0010
+    PERIPHERALS_8BIT        : origin = 0x0010, length = 0x00F0
+    PERIPHERALS_16BIT       : origin = 0x0100, length = 0x0100
+    RAM                     : origin = 0x0380, length = 0x0680
+    INFOA                   : origin = 0x10C0, length = 0x0040
+    INFOB                   : origin = 0x1080, length = 0x0040
+    INFOC                   : origin = 0x1040, length = 0x0040
+    INFOD                   : origin = 0x1000, length = 0x0040
+    APPINT00                : origin = 0xC000, length = 0x0002
+    APPINT01                : origin = 0xC002, length = 0x0002
+    APPINT02                : origin = 0xC004, length = 0x0002
+    APPINT03                : origin = 0xC006, length = 0x0002
+    APPINT04                : origin = 0xC008, length = 0x0002
+    APPINT05                : origin = 0xC00A, length = 0x0002
+    APPINT06                : origin = 0xC00C, length = 0x0002
+    APPINT07                : origin = 0xC00E, length = 0x0002
+    APPINT08                : origin = 0xC010, length = 0x0002
+    APPINT09                : origin = 0xC012, length = 0x0002
+    APPINT10                : origin = 0xC014, length = 0x0002
+    APPINT11                : origin = 0xC016, length = 0x0002
+    APPINT12                : origin = 0xC018, length = 0x0002
+    APPINT13                : origin = 0xC01A, length = 0x0002
+    APPINT14                : origin = 0xC01C, length = 0x0002
+    APPRESET                : origin = 0xC01E, length = 0x0002
+    FLASH                   : origin = 0xC020, length = 0x2DE0
+}
+
+/****************************************************************************/
+/* SPECIFY THE SECTIONS ALLOCATION INTO MEMORY                              */
+/****************************************************************************/
+
+SECTIONS
+{
+    .bss       : {} > RAM                /* GLOBAL & STATIC VARS              */
+    .sysmem    : {} > RAM                /* DYNAMIC MEMORY ALLOCATION AREA    */
+    .stack     : {} > RAM (HIGH)         /* SOFTWARE SYSTEM STACK             */
+
+    .text      : {} > FLASH              /* CODE                              */
+    .cinit     : {} > FLASH              /* INITIALIZATION TABLES             */
+    .const     : {} > FLASH              /* CONSTANT DATA                     */
+    .cio       : {} > RAM                /* C I/O BUFFER                      */
+
+    .pinit     : {} > FLASH              /* C++ CONSTRUCTOR TABLES            */
+
+    .infoA     : {} > INFOA              /* MSP430 INFO FLASH MEMORY SEGMENTS */
+    .infoB     : {} > INFOB
+    .infoC     : {} > INFOC
+    .infoD     : {} > INFOD
+
+    /* THE VECTORS GO IN THE APPLICATION VECTOR TABLE AT THE START OF      */
+    /* FLASH, THE BOOT TRAMPOLINES JUMP THROUGH IT. THE CP LINK VECTORS    */
+    /* ARE IN THE BOOT LINK, THE BOOT AREA STARTS THE APPLICATION THROUGH  */
+    /* THE APPLICATION RESET VECTOR.                                       */
+    .int00   : {} > APPINT00
+    .int01   : {} > APPINT01
+    .int02   : {} > APPINT02
+    .int04   : {} > APPINT04
+    .int05   : {} > APPINT05
+    .int06   : {} > APPINT06
+    .int07   : {} > APPINT07
+    .int10   : {} > APPINT10
+    .int11   : {} > APPINT11
+    .int12   : {} > APPINT12
+    .int13   : {} > APPINT13
+    .int14   : {} > APPINT14
+    .reset   : {} > APPRESET           /* APPLICATION ENTRY POINT           */
+}
+
+/****************************************************************************/
+/* INCLUDE PERIPHERALS MEMORY MAP                                           */
+/****************************************************************************/
+
+-l msp430f235.cmd
+
@@ -0,0 +1,113 @@
+/******************************************************************************/
+/* lnk_msp430f235_boot.cmd - LINKER COMMAND FILE FOR THE BOOT AREA OF         */
+/*                           MSP430F235 PROGRAMS WITH SP_FIRMWARE_UPDATE SET  */
+/*                           TO 1                                             */
+/*                                                                            */
+/*   Links boot.c, comm.c and the C startup on their own. This image is       */
+/*   programmed once and never rewritten. The application is linked with      */
+/*   lnk_msp430f235_app.cmd and only reaches this image through the jump      */
+/*   table at the start of BOOT, so the two are linked separately.            */
+/*                                                                            */
+/*   Usage:  lnk430 <obj files...>    -o <out file> -m <map file> lnk.cmd     */
+/*           cl430  <src files...> -z -o <out file> -m <map file> lnk.cmd     */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+/* These linker options are for command line linking only.  For IDE linking,  */
+/* you should set your linker options in Project Properties                   */
+/* -c                                               LINK USING C CONVENTIONS  */
+/* -stack  0x0100                                   SOFTWARE STACK SIZE       */
+/* -heap   0x0100                                   HEAP AREA SIZE            */
+/*                                                                            */
+/*----------------------------------------------------------------------------*/
+
+
+/****************************************************************************/
+/* SPECIFY THE SYSTEM MEMORY MAP                                            */
+/****************************************************************************/
+
+MEMORY
+{
+    SFR                     : origin = 0x0000, length = 0x0010
+    PERIPHERALS_8BIT        : origin = 0x0010, length = 0x00F0
+    PERIPHERALS_16BIT       : origin = 0x0100, length = 0x0100
+    BOOTRAM                 : origin = 0x0200, length = 0x0180
+    RAM                     : origin = 0x0380, length = 0x0680
+    INFOA                   : origin = 0x10C0, length = 0x0040
+    INFOB                   : origin = 0x1080, length = 0x0040
+    INFOC                   : origin = 0x1040, length = 0x0040
+    INFOD                   : origin = 0x1000, length = 0x0040
+    BOOTJUMP                : origin = 0xEE00, length = 0x0080
+    BOOT                    : origin = 0xEE80, length = 0x0F80
+    INT00                   : origin = 0xFFE0, length = 0x0002
+    INT01                   : origin = 0xFFE2, length = 0x0002
+    INT02                   : origin = 0xFFE4, length = 0x0002
+    INT03                   : origin = 0xFFE6, length = 0x0002
+    INT04                   : origin = 0xFFE8, length = 0x0002
+    INT05                   : origin = 0xFFEA, length = 0x0002
+    INT06                   : origin = 0xFFEC, length = 0x0002
+    INT07                   : origin = 0xFFEE, length = 0x0002
+    INT08                   : origin = 0xFFF0, length = 0x0002
+    INT09                   : origin = 0xFFF2, length = 0x0002
+    INT10                   : origin = 0xFFF4, length = 0x0002
+    INT11                   : origin = 0xFFF6, length = 0x0002
+    INT12                   : origin = 0xFFF8, length = 0x0002
+    INT13                   : origin = 0xFFFA, length = 0x0002
+    INT14                   : origin = 0xFFFC, length = 0x0002
+    RESET                   : origin = 0xFFFE, length = 0x0002
+}
+
+/****************************************************************************/
+/* SPECIFY THE SECTIONS ALLOCATION INTO MEMORY                              */
+/****************************************************************************/
+
+SECTIONS
+{
+    /* ONLY .bss STAYS IN BOOTRAM, THE APPLICATION NEVER USES IT. THE      */
+    /* SEGMENT BUFFER AND THE STACK SHARE RAM WITH THE APPLICATION, WHICH  */
+    /* IS NOT RUNNING WHILE THEY ARE IN USE.                               */
+    .bss       : {} > BOOTRAM            /* GLOBAL & STATIC VARS              */
+    .bootbuf   : {} > RAM                /* FIRMWARE UPDATE SEGMENT BUFFER    */
+    .sysmem    : {} > RAM                /* DYNAMIC MEMORY ALLOCATION AREA    */
+    .stack     : {} > RAM (HIGH)         /* SOFTWARE SYSTEM STACK             */
+
+    /* THE JUMP TABLE IS THE ONLY WAY INTO THIS IMAGE, IT MUST NOT MOVE.   */
+    .bootjump  : {} > BOOTJUMP           /* JUMP TABLE FOR THE APPLICATION    */
+    .text      : {} > BOOT               /* CODE                              */
+    .cinit     : {} > BOOT               /* INITIALIZATION TABLES             */
+    .const     : {} > BOOT               /* CONSTANT DATA                     */
+    .cio       : {} > RAM                /* C I/O BUFFER                      */
+
+    .pinit     : {} > BOOT               /* C++ CONSTRUCTOR TABLES            */
+
+    .infoA     : {} > INFOA              /* MSP430 INFO FLASH MEMORY SEGMENTS */
+    .infoB     : {} > INFOB
+    .infoC     : {} > INFOC
+    .infoD     : {} > INFOD
+
+    /* THE VECTOR SEGMENT BELONGS TO BOOT. THE CP LINK VECTORS POINT INTO  */
+    /* comm.obj, THE OTHERS TO THE TRAMPOLINES IN boot.obj, WHICH JUMP     */
+    /* THROUGH THE APPLICATION VECTOR TABLE AT THE START OF FLASH.         */
+    .int03   : {} > INT03
+    .int08   : {} > INT08
+    .int09   : {} > INT09
+    .bootint00  : {} > INT00
+    .bootint01  : {} > INT01
+    .bootint02  : {} > INT02
+    .bootint04  : {} > INT04
+    .bootint05  : {} > INT05
+    .bootint06  : {} > INT06
+    .bootint07  : {} > INT07
+    .bootint10  : {} > INT10
+    .bootint11  : {} > INT11
+    .bootint12  : {} > INT12
+    .bootint13  : {} > INT13
+    .bootint14  : {} > INT14
+    .reset   : {} > RESET              /* MSP430 RESET VECTOR               */
+}
+
+/****************************************************************************/
+/* INCLUDE PERIPHERALS MEMORY MAP                                           */
+/****************************************************************************/
+
+-l msp430f235.cmd
+
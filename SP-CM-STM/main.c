@@ -1,965 +1,323 @@
-//*****************************************************************************
-// main.c
-//
-// By: Samuel Boegli
-//     Wireless Networks Research Lab
-//     Dept of Electrical Engineering, CEFNS
-//     Northern Arizona University
-//
-// SP-CM-STM Main
-//*****************************************************************************
-
-#include <msp430x23x.h>
-#include "core/core.h"
-
-//UARTDELETE
-const char splash[] = {"\r\n--------------------------------------------------\r\n     ########      |      NAU WNRL and MSP430\r\n    # $$##$$ #     |	       Present:\r\n     $  ##  $ #    |          SP-CM-STM\r\n      $$##   #     |            V 2.0\r\n        #####      |       No Copyright 2012\r\n        ##$$ #     |\r\n     $  ##  $ #    |    Written and Directed By:\r\n    # $$##$$ #     |         Samuel Boegli\r\n     ########      |\r\n--------------------------------------------------\r\n"};
-//const char splash[] = {"\r\n------------------ SP-CM-STM V2 Code ------------------\r\n"};
-
-char cValve_Initialized = 0;//To make sure we initialize only once.
-char c5TM_Initialized = 0;
-
-
-char main_Do5TM1(void);
-char main_Do5TM2(void);
-
-
-
-//Obsolete test functions
-/*
-uint16 vDUMMY_AddData(uint16 * input1, uint16 * input2)
-{
-	*input1 = (*input1 + *(input2+1));
-	return 1;
-}
-
-uint16 vDUMMY_SubtractData(uint16 * input1, uint16 * input2)
-{
-	*input1 = (*input1 - *(input2+1));
-	return 1;
-}
-
-uint16 vDUMMY_MultiplyData(uint16 * input1, uint16 * input2)
-{
-	*input1 = (*input1 * *(input2+1));
-	return 1;
-}
-
-uint16 vDUMMY_DivideData(uint16 * input1, uint16 * input2)
-{
-	*input1 = (*input1 / *(input2+1));
-	return 1;
-}
-*/
-
-
-///////////////////////////////////////////////////////////////////////////////
-//!   \brief Handle for when Test Function is called
-//!
-//!   Sends a UART message what the command was.
-//!
-//!   \param pointer to an array where data will be placed
-//!
-//!   \return 1: success, 0: failure
-///////////////////////////////////////////////////////////////////////////////
-uint16 main_Test(uint16 * arr)
-{
-//	vUARTCOM_TXString("Test Function\r\n",15);
-	return 1;
-}
-
-///////////////////////////////////////////////////////////////////////////////
-//!   \brief Handle for when Transducer 1 is called
-//!
-//!   Sends a UART message what the command was, and activates 5TM 1
-//!
-//!   \param pointer to an array where data will be placed
-//!
-//!   \return 1: success, 0: failure
-///////////////////////////////////////////////////////////////////////////////
-uint16 main_STM1(uint16 * arr)
-{
-	if(!c5TM_Initialized)
-	{
-		v5TM_Initialize();
-		c5TM_Initialized = 1;
-	}
-
-	char result = main_Do5TM1();
-	if(result == 1){
-		*(arr+4) = i5TM_GetSoil(1);
-		*(arr+5) = i5TM_GetTemp(1);
-	}else if(result == 0){
-		*(arr+4) = FIVETM_ERROR_CODE_1;
-	}else if(result == 2){
-		*(arr+4) = FIVETM_ERROR_CODE_2;
-		result = 0;
-	}
-
-	return result;
-}
-///////////////////////////////////////////////////////////////////////////////
-//!   \brief Handle for when Transducer 2 is called
-//!
-//!   Sends a UART message what the command was, and activates 5TM 2
-//!
-//!   \param pointer to an array where data will be placed
-//!
-//!   \return 1: success, 0: failure
-///////////////////////////////////////////////////////////////////////////////
-uint16 main_STM2(uint16 * arr)
-{
-	if(!c5TM_Initialized)
-	{
-		v5TM_Initialize();
-		c5TM_Initialized = 1;
-	}
-
-	char result = main_Do5TM2();
-	if(result == 1){
-		*(arr+6) = i5TM_GetSoil(2);
-		*(arr+7) = i5TM_GetTemp(2);
-	}else if(result == 0){
-		*(arr+6) = FIVETM_ERROR_CODE_1;
-	}else if(result == 2){
-		*(arr+6) = FIVETM_ERROR_CODE_2;
-		result = 0;
-	}
-
-	return result;
-}
-
-
-
-///////////////////////////////////////////////////////////////////////////////
-//!   \brief Handle for when Transducer 3 is called
-//!
-//!   Sends a UART message what the command was, and activates 5TM 1 and 2
-//!
-//!   \param pointer to an array where data will be placed
-//!
-//!   \return 1: success, 0: failure
-///////////////////////////////////////////////////////////////////////////////
-uint16 main_STM12(uint16 * arr)
-{
-	if(!c5TM_Initialized)
-	{
-		v5TM_Initialize();
-		c5TM_Initialized = 1;
-	}
-	char result1 = main_Do5TM1();
-	if(result1 == 1){
-		*(arr+4) = i5TM_GetSoil(1);
-		*(arr+5) = i5TM_GetTemp(1);
-	}else if(result1 == 0){
-		*(arr+4) = FIVETM_ERROR_CODE_1;
-	}else if(result1 == 2){
-		*(arr+4) = FIVETM_ERROR_CODE_2;
-		result1 = 0;
-	}
-
-
-	char result2 = main_Do5TM2();
-	if(result2 == 1){
-		*(arr+6) = i5TM_GetSoil(2);
-		*(arr+7) = i5TM_GetTemp(2);
-	}else if(result2 == 0){
-		*(arr+6) = FIVETM_ERROR_CODE_1;
-	}else if(result2 == 2){
-		*(arr+6) = FIVETM_ERROR_CODE_2;
-		result2 = 0;
-	}
-
-	if(result1 && result2)
-		return 1;
-	return 0;
-}
-
-
-///////////////////////////////////////////////////////////////////////////////
-//!   \brief Handle for when Transducer 4 is called
-//!
-//!   Sends a UART message what the command was, and activates or
-//!   deactivates valve 1, depending on the parameter.
-//!
-//!   \param g_unaCoreData.
-//!		 A pointer at the data that came from the CP board and where the answer
-//!      is to be written. 0x00: Turn off, 0x5B: Turn on
-//!
-//!   \return 1: success, 0: failure
-///////////////////////////////////////////////////////////////////////////////
-uint16 main_CM1(uint16 * arr)
-{
-	if(!cValve_Initialized)
-	{
-		vVALVE_Initialize();
-	    cValve_Initialized = 1;
-	}
-	//UARTDELETE
-//	if(*arr == VALVE_ON)
-//		vUARTCOM_TXString("CP-Valve 1 On\r\n",15);
-//	if(*arr == VALVE_OFF)
-//		vUARTCOM_TXString("CP-Valve 1 Off\r\n",16);
-	char result = unVALVE_Set1(*arr);
-	if(!result)
-		*(arr) = VALVE_PRE_FAULT_ERROR_CODE;
-	if(result == 2)
-	{
-		*(arr) = VALVE_POST_FAULT_ERROR_CODE;
-		result = 0;
-	}
-	return result;
-}
-
-
-///////////////////////////////////////////////////////////////////////////////
-//!   \brief Handle for when Transducer 5 is called
-//!
-//!   Sends a UART message what the command was, and activates or
-//!   deactivates valve 1, depending on the parameter. Then activates 5TM 1.
-//!
-//!   \param g_unaCoreData.
-//!		 A pointer at the data that came from the CP board and where the answer
-//!      is to be written. 0x00: Turn off, 0x5B: Turn on
-//!		 Data for 5TM is also written here
-//!
-//!   \return 1: success, 0: failure
-///////////////////////////////////////////////////////////////////////////////
-uint16 main_CM1_STM1(uint16 * arr)
-{
-	if(!cValve_Initialized)
-	{
-		vVALVE_Initialize();
-	    cValve_Initialized = 1;
-	}
-	if(!c5TM_Initialized)
-	{
-		v5TM_Initialize();
-		c5TM_Initialized = 1;
-	}
-	//UARTDELETE
-//	if(*arr == VALVE_ON)
-//		vUARTCOM_TXString("CP-Valve 1 On\r\n",15);
-//	if(*arr == VALVE_OFF)
-//		vUARTCOM_TXString("CP-Valve 1 Off\r\n",16);
-	char result1 = unVALVE_Set1(*arr);
-	if(!result1)
-		*(arr) = VALVE_PRE_FAULT_ERROR_CODE;
-	if(result1 == 2)
-	{
-		*(arr) = VALVE_POST_FAULT_ERROR_CODE;
-		result1 = 0;
-	}
-
-	char result2 = main_Do5TM1();
-	if(result2 == 1){
-		*(arr+4) = i5TM_GetSoil(1);
-		*(arr+5) = i5TM_GetTemp(1);
-	}else if(result2 == 0){
-		*(arr+4) = FIVETM_ERROR_CODE_1;
-	}else if(result2 == 2){
-		*(arr+4) = FIVETM_ERROR_CODE_2;
-		result2 = 0;
-	}
-
-	if(result1 && result2)
-		return 1;
-	return 0;
-}
-
-///////////////////////////////////////////////////////////////////////////////
-//!   \brief Handle for when Transducer 6 is called
-//!
-//!   Sends a UART message what the command was, and activates or
-//!   deactivates valve 1, depending on the parameter. Then activates 5TM 2.
-//!
-//!   \param g_unaCoreData.
-//!		 A pointer at the data that came from the CP board and where the answer
-//!      is to be written. 0x00: Turn off, 0x5B: Turn on
-//!		 Data for 5TM is also written here
-//!
-//!   \return 1: success, 0: failure
-///////////////////////////////////////////////////////////////////////////////
-uint16 main_CM1_STM2(uint16 * arr)
-{
-	if(!cValve_Initialized)
-	{
-		vVALVE_Initialize();
-	    cValve_Initialized = 1;
-	}
-	if(!c5TM_Initialized)
-	{
-		v5TM_Initialize();
-		c5TM_Initialized = 1;
-	}
-	//UARTDELETE
-//	if(*arr == VALVE_ON)
-//		vUARTCOM_TXString("CP-Valve 1 On\r\n",15);
-//	if(*arr == VALVE_OFF)
-//		vUARTCOM_TXString("CP-Valve 1 Off\r\n",16);
-	char result1 = unVALVE_Set1(*arr);
-	if(!result1)
-		*(arr) = VALVE_PRE_FAULT_ERROR_CODE;
-	if(result1 == 2)
-	{
-		*(arr) = VALVE_POST_FAULT_ERROR_CODE;
-		result1 = 0;
-	}
-
-	char result2 = main_Do5TM2();
-	if(result2 == 1){
-		*(arr+6) = i5TM_GetSoil(2);
-		*(arr+7) = i5TM_GetTemp(2);
-	}else if(result2 == 0){
-		*(arr+6) = FIVETM_ERROR_CODE_1;
-	}else if(result2 == 2){
-		*(arr+6) = FIVETM_ERROR_CODE_2;
-		result2 = 0;
-	}
-
-	if(result1 && result2)
-		return 1;
-	return 0;
-}
-
-///////////////////////////////////////////////////////////////////////////////
-//!   \brief Handle for when Transducer 7 is called
-//!
-//!   Sends a UART message what the command was, and activates or
-//!   deactivates valve 1, depending on the parameter. Then activates 5TM 1 and 2.
-//!
-//!   \param g_unaCoreData.
-//!		 A pointer at the data that came from the CP board and where the answer
-//!      is to be written. 0x00: Turn off, 0x5B: Turn on
-//!		 Data for 5TM is also written here
-//!
-//!   \return 1: success, 0: failure
-///////////////////////////////////////////////////////////////////////////////
-uint16 main_CM1_STM12(uint16 * arr)
-{
-	if(!cValve_Initialized)
-	{
-		vVALVE_Initialize();
-	    cValve_Initialized = 1;
-	}
-	if(!c5TM_Initialized)
-	{
-		v5TM_Initialize();
-		c5TM_Initialized = 1;
-	}
-	//UARTDELETE
-//	if(*arr == VALVE_ON)
-//		vUARTCOM_TXString("CP-Valve 1 On\r\n",15);
-//	if(*arr == VALVE_OFF)
-//		vUARTCOM_TXString("CP-Valve 1 Off\r\n",16);
-	char result1 = unVALVE_Set1(*arr);
-	if(!result1)
-		*(arr) = VALVE_PRE_FAULT_ERROR_CODE;
-	if(result1 == 2)
-	{
-		*(arr) = VALVE_POST_FAULT_ERROR_CODE;
-		result1 = 0;
-	}
-
-	char result2 = main_Do5TM1();
-	if(result2 == 1){
-		*(arr+4) = i5TM_GetSoil(1);
-		*(arr+5) = i5TM_GetTemp(1);
-	}else if(result2 == 0){
-		*(arr+4) = FIVETM_ERROR_CODE_1;
-	}else if(result2 == 2){
-		*(arr+4) = FIVETM_ERROR_CODE_2;
-		result2 = 0;
-	}
-
-	char result3 = main_Do5TM2();
-	if(result3 == 1){
-		*(arr+6) = i5TM_GetSoil(2);
-		*(arr+7) = i5TM_GetTemp(2);
-	}else if(result3 == 0){
-		*(arr+6) = FIVETM_ERROR_CODE_1;
-	}else if(result3 == 2){
-		*(arr+6) = FIVETM_ERROR_CODE_2;
-		result3 = 0;
-	}
-
-	if(result1 && result2 && result3)
-		return 1;
-	return 0;
-}
-
-
-///////////////////////////////////////////////////////////////////////////////
-//!   \brief Handle for when Transducer 8 is called
-//!
-//!   Sends a UART message what the command was, and activates or
-//!   deactivates valve 2, depending on the parameter
-//!
-//!   \param g_unaCoreData.
-//!		 A pointer at the data that came from the CP board and where the answer
-//!      is to be written. 0x00: Turn off, 0x5B: Turn on
-//!
-//!   \return 1: success, 0: failure
-///////////////////////////////////////////////////////////////////////////////
-uint16 main_CM2(uint16 * arr)
-{
-	if(!cValve_Initialized)
-	{
-		vVALVE_Initialize();
-	    cValve_Initialized = 1;
-	}
-	//UARTDELETE
-//	if(*(arr+1) == VALVE_ON)
-//		vUARTCOM_TXString("CP-Valve 2 On\r\n",15);
-//	if(*(arr+1) == VALVE_OFF)
-//		vUARTCOM_TXString("CP-Valve 2 Off\r\n",16);
-	char result = unVALVE_Set2(*(arr+1));
-	if(!result)
-		*(arr+1) = VALVE_PRE_FAULT_ERROR_CODE;
-	if(result == 2)
-	{
-		*(arr+1) = VALVE_POST_FAULT_ERROR_CODE;
-		result = 0;
-	}
-	return result;
-}
-
-///////////////////////////////////////////////////////////////////////////////
-//!   \brief Handle for when Transducer 9 is called
-//!
-//!   Sends a UART message what the command was, and activates or
-//!   deactivates valve 2, depending on the parameter. Then activates 5TM 1.
-//!
-//!   \param g_unaCoreData.
-//!		 A pointer at the data that came from the CP board and where the answer
-//!      is to be written. 0x00: Turn off, 0x5B: Turn on
-//!		 Data for 5TM is also written here
-//!
-//!   \return 1: success, 0: failure
-///////////////////////////////////////////////////////////////////////////////
-uint16 main_CM2_STM1(uint16 * arr)
-{
-	if(!cValve_Initialized)
-	{
-		vVALVE_Initialize();
-	    cValve_Initialized = 1;
-	}
-	if(!c5TM_Initialized)
-	{
-		v5TM_Initialize();
-		c5TM_Initialized = 1;
-	}
-
-	//UARTDELETE
-//	if(*(arr+1) == VALVE_ON)
-//		vUARTCOM_TXString("CP-Valve 2 On\r\n",15);
-//	if(*(arr+1) == VALVE_OFF)
-//		vUARTCOM_TXString("CP-Valve 2 Off\r\n",16);
-	char result1 = unVALVE_Set2(*(arr+1));
-	if(!result1)
-		*(arr+1) = VALVE_PRE_FAULT_ERROR_CODE;
-	if(result1 == 2)
-	{
-		*(arr+1) = VALVE_POST_FAULT_ERROR_CODE;
-		result1 = 0;
-	}
-
-	char result2 = main_Do5TM1();
-	if(result2 == 1){
-		*(arr+4) = i5TM_GetSoil(1);
-		*(arr+5) = i5TM_GetTemp(1);
-	}else if(result2 == 0){
-		*(arr+4) = FIVETM_ERROR_CODE_1;
-	}else if(result2 == 2){
-		*(arr+4) = FIVETM_ERROR_CODE_2;
-		result2 = 0;
-	}
-
-	if(result1 && result2)
-		return 1;
-	return 0;
-}
-
-///////////////////////////////////////////////////////////////////////////////
-//!   \brief Handle for when Transducer A is called
-//!
-//!   Sends a UART message what the command was, and activates or
-//!   deactivates valve 2, depending on the parameter. Then activates 5TM 2.
-//!
-//!   \param g_unaCoreData.
-//!		 A pointer at the data that came from the CP board and where the answer
-//!      is to be written. 0x00: Turn off, 0x5B: Turn on
-//!		 Data for 5TM is also written here
-//!
-//!   \return 1: success, 0: failure
-///////////////////////////////////////////////////////////////////////////////
-uint16 main_CM2_STM2(uint16 * arr)
-{
-	if(!cValve_Initialized)
-	{
-		vVALVE_Initialize();
-	    cValve_Initialized = 1;
-	}
-	if(!c5TM_Initialized)
-	{
-		v5TM_Initialize();
-		c5TM_Initialized = 1;
-	}
-
-	//UARTDELETE
-//	if(*(arr+1) == VALVE_ON)
-//		vUARTCOM_TXString("CP-Valve 2 On\r\n",15);
-//	if(*(arr+1) == VALVE_OFF)
-//		vUARTCOM_TXString("CP-Valve 2 Off\r\n",16);
-	char result1 = unVALVE_Set2(*(arr+1));
-	if(!result1)
-		*(arr+1) = VALVE_PRE_FAULT_ERROR_CODE;
-	if(result1 == 2)
-	{
-		*(arr+1) = VALVE_POST_FAULT_ERROR_CODE;
-		result1 = 0;
-	}
-
-	char result2 = main_Do5TM2();
-	if(result2 == 1){
-		*(arr+6) = i5TM_GetSoil(2);
-		*(arr+7) = i5TM_GetTemp(2);
-	}else if(result2 == 0){
-		*(arr+6) = FIVETM_ERROR_CODE_1;
-	}else if(result2 == 2){
-		*(arr+6) = FIVETM_ERROR_CODE_2;
-		result2 = 0;
-	}
-
-	if(result1 && result2)
-		return 1;
-	return 0;
-}
-
-
-///////////////////////////////////////////////////////////////////////////////
-//!   \brief Handle for when Transducer B is called
-//!
-//!   Sends a UART message what the command was, and activates or
-//!   deactivates valve 2, depending on the parameter. Then activates 5TM 1 and 2.
-//!
-//!   \param g_unaCoreData.
-//!		 A pointer at the data that came from the CP board and where the answer
-//!      is to be written. 0x00: Turn off, 0x5B: Turn on
-//!		 Data for 5TM is also written here
-//!
-//!   \return 1: success, 0: failure
-///////////////////////////////////////////////////////////////////////////////
-uint16 main_CM2_STM12(uint16 * arr)
-{
-	if(!cValve_Initialized)
-	{
-		vVALVE_Initialize();
-	    cValve_Initialized = 1;
-	}
-	if(!c5TM_Initialized)
-	{
-		v5TM_Initialize();
-		c5TM_Initialized = 1;
-	}
-
-	//UARTDELETE
-//	if(*(arr+1) == VALVE_ON)
-//		vUARTCOM_TXString("CP-Valve 2 On\r\n",15);
-//	if(*(arr+1) == VALVE_OFF)
-//		vUARTCOM_TXString("CP-Valve 2 Off\r\n",16);
-	char result1 = unVALVE_Set2(*(arr+1));
-	if(!result1)
-		*(arr+1) = VALVE_PRE_FAULT_ERROR_CODE;
-	if(result1 == 2)
-	{
-		*(arr+1) = VALVE_POST_FAULT_ERROR_CODE;
-		result1 = 0;
-	}
-
-	char result2 = main_Do5TM1();
-	if(result2 == 1){
-		*(arr+4) = i5TM_GetSoil(1);
-		*(arr+5) = i5TM_GetTemp(1);
-	}else if(result2 == 0){
-		*(arr+4) = FIVETM_ERROR_CODE_1;
-	}else if(result2 == 2){
-		*(arr+4) = FIVETM_ERROR_CODE_2;
-		result2 = 0;
-	}
-
-	char result3 = main_Do5TM2();
-	if(result3 == 1){
-		*(arr+6) = i5TM_GetSoil(2);
-		*(arr+7) = i5TM_GetTemp(2);
-	}else if(result3 == 0){
-		*(arr+6) = FIVETM_ERROR_CODE_1;
-	}else if(result3 == 2){
-		*(arr+6) = FIVETM_ERROR_CODE_2;
-		result3 = 0;
-	}
-
-	if(result1 && result2 && result3)
-		return 1;
-	return 0;
-}
-
-
-///////////////////////////////////////////////////////////////////////////////
-//!   \brief Handle for when Transducer C is called
-//!
-//!   Sends a UART message what the command was, and activates or deactivates
-//!   valves 1 and 2, depending on the parameters.
-//!
-//!   \param g_unaCoreData.
-//!		 A pointer at the data that came from the CP board and where the answer
-//!      is to be written. 0x00: Turn off, 0x5B: Turn on
-//!
-//!   \return 1: success, 0: failure
-///////////////////////////////////////////////////////////////////////////////
-uint16 main_CM12(uint16 * arr)
-{
-	if(!cValve_Initialized)
-	{
-		vVALVE_Initialize();
-	    cValve_Initialized = 1;
-	}
-
-//	if(*arr == VALVE_ON)
-//		vUARTCOM_TXString("CP-Valve 1 On\r\n",15);
-//	if(*arr == VALVE_OFF)
-//		vUARTCOM_TXString("CP-Valve 1 Off\r\n",16);
-	char result1 = unVALVE_Set1(*arr);
-	if(!result1)
-		*(arr) = VALVE_PRE_FAULT_ERROR_CODE;
-	if(result1 == 2)
-	{
-		*(arr) = VALVE_POST_FAULT_ERROR_CODE;
-		result1 = 0;
-	}
-
-//	if(*(arr+1) == VALVE_ON)
-//		vUARTCOM_TXString("CP-Valve 1 On\r\n",15);
-//	if(*(arr+1) == VALVE_OFF)
-//		vUARTCOM_TXString("CP-Valve 1 Off\r\n",16);
-	char result2 = unVALVE_Set2(*(arr+1));
-	if(!result2)
-		*(arr+1) = VALVE_PRE_FAULT_ERROR_CODE;
-	if(result2 == 2)
-	{
-		*(arr+1) = VALVE_POST_FAULT_ERROR_CODE;
-		result2 = 0;
-	}
-
-
-	if(result1 && result2)
-		return 1;
-	return 0;
-}
-
-
-///////////////////////////////////////////////////////////////////////////////
-//!   \brief Handle for when Transducer D is called
-//!
-//!   Sends a UART message what the command was, and activates or deactivates
-//!   valves 1 and 2, depending on the parameters. Then activates 5TM 1.
-//!
-//!   \param g_unaCoreData.
-//!		 A pointer at the data that came from the CP board and where the answer
-//!      is to be written. 0x00: Turn off, 0x5B: Turn on
-//!		 Data for 5TM is also written here
-//!
-//!   \return 1: success, 0: failure
-///////////////////////////////////////////////////////////////////////////////
-uint16 main_CM12_STM1(uint16 * arr)
-{
-	if(!cValve_Initialized)
-	{
-		vVALVE_Initialize();
-	    cValve_Initialized = 1;
-	}
-	if(!c5TM_Initialized)
-	{
-		v5TM_Initialize();
-		c5TM_Initialized = 1;
-	}
-
-//	if(*arr == VALVE_ON)
-//		vUARTCOM_TXString("CP-Valve 1 On\r\n",15);
-//	if(*arr == VALVE_OFF)
-//		vUARTCOM_TXString("CP-Valve 1 Off\r\n",16);
-	char result1 = unVALVE_Set1(*arr);
-	if(!result1)
-		*(arr) = VALVE_PRE_FAULT_ERROR_CODE;
-	if(result1 == 2)
-	{
-		*(arr) = VALVE_POST_FAULT_ERROR_CODE;
-		result1 = 0;
-	}
-
-//	if(*(arr+1) == VALVE_ON)
-//		vUARTCOM_TXString("CP-Valve 1 On\r\n",15);
-//	if(*(arr+1) == VALVE_OFF)
-//		vUARTCOM_TXString("CP-Valve 1 Off\r\n",16);
-	char result2 = unVALVE_Set2(*(arr+1));
-	if(!result2)
-		*(arr+1) = VALVE_PRE_FAULT_ERROR_CODE;
-	if(result2 == 2)
-	{
-		*(arr+1) = VALVE_POST_FAULT_ERROR_CODE;
-		result2 = 0;
-	}
-
-
-
-	char result3 = main_Do5TM1();
-	if(result3 == 1){
-		*(arr+4) = i5TM_GetSoil(1);
-		*(arr+5) = i5TM_GetTemp(1);
-	}else if(result3 == 0){
-		*(arr+4) = FIVETM_ERROR_CODE_1;
-	}else if(result3 == 2){
-		*(arr+4) = FIVETM_ERROR_CODE_2;
-		result3 = 0;
-	}
-
-	if(result1 && result2 && result3)
-		return 1;
-	return 0;
-}
-
-///////////////////////////////////////////////////////////////////////////////
-//!   \brief Handle for when Transducer E is called
-//!
-//!   Sends a UART message what the command was, and activates or deactivates
-//!   valves 1 and 2, depending on the parameters. Then activates 5TM 2.
-//!
-//!   \param g_unaCoreData.
-//!		 A pointer at the data that came from the CP board and where the answer
-//!      is to be written. 0x00: Turn off, 0x5B: Turn on
-//!		 Data for 5TM is also written here
-//!
-//!   \return 1: success, 0: failure
-///////////////////////////////////////////////////////////////////////////////
-uint16 main_CM12_STM2(uint16 * arr)
-{
-	if(!cValve_Initialized)
-	{
-		vVALVE_Initialize();
-	    cValve_Initialized = 1;
-	}
-	if(!c5TM_Initialized)
-	{
-		v5TM_Initialize();
-		c5TM_Initialized = 1;
-	}
-
-//	if(*arr == VALVE_ON)
-//		vUARTCOM_TXString("CP-Valve 1 On\r\n",15);
-//	if(*arr == VALVE_OFF)
-//		vUARTCOM_TXString("CP-Valve 1 Off\r\n",16);
-	char result1 = unVALVE_Set1(*arr);
-	if(!result1)
-		*(arr) = VALVE_PRE_FAULT_ERROR_CODE;
-	if(result1 == 2)
-	{
-		*(arr) = VALVE_POST_FAULT_ERROR_CODE;
-		result1 = 0;
-	}
-
-//	if(*(arr+1) == VALVE_ON)
-//		vUARTCOM_TXString("CP-Valve 1 On\r\n",15);
-//	if(*(arr+1) == VALVE_OFF)
-//		vUARTCOM_TXString("CP-Valve 1 Off\r\n",16);
-	char result2 = unVALVE_Set2(*(arr+1));
-	if(!result2)
-		*(arr+1) = VALVE_PRE_FAULT_ERROR_CODE;
-	if(result2 == 2)
-	{
-		*(arr+1) = VALVE_POST_FAULT_ERROR_CODE;
-		result2 = 0;
-	}
-
-
-	char result3 = main_Do5TM2();
-	if(result3 == 1){
-		*(arr+6) = i5TM_GetSoil(2);
-		*(arr+7) = i5TM_GetTemp(2);
-	}else if(result3 == 0){
-		*(arr+6) = FIVETM_ERROR_CODE_1;
-	}else if(result3 == 2){
-		*(arr+6) = FIVETM_ERROR_CODE_2;
-		result3 = 0;
-	}
-
-	if(result1 && result2 && result3)
-		return 1;
-	return 0;
-}
-
-///////////////////////////////////////////////////////////////////////////////
-//!   \brief Handle for when Transducer F is called
-//!
-//!   Sends a UART message what the command was, and activates or deactivates
-//!   valves 1 and 2, depending on the parameters. Then activates 5TM 1 and 2.
-//!
-//!   \param g_unaCoreData.
-//!		 A pointer at the data that came from the CP board and where the answer
-//!      is to be written. 0x00: Turn off, 0x5B: Turn on
-//!		 Data for 5TM is also written here
-//!
-//!   \return 1: success, 0: failure
-///////////////////////////////////////////////////////////////////////////////
-uint16 main_CM12_STM12(uint16 * arr)
-{
-	if(!cValve_Initialized)
-	{
-		vVALVE_Initialize();
-	    cValve_Initialized = 1;
-	}
-	if(!c5TM_Initialized)
-	{
-		v5TM_Initialize();
-		c5TM_Initialized = 1;
-	}
-
-//	if(*arr == VALVE_ON)
-//		vUARTCOM_TXString("CP-Valve 1 On\r\n",15);
-//	if(*arr == VALVE_OFF)
-//		vUARTCOM_TXString("CP-Valve 1 Off\r\n",16);
-	char result1 = unVALVE_Set1(*arr);
-	if(!result1)
-		*(arr) = VALVE_PRE_FAULT_ERROR_CODE;
-	if(result1 == 2)
-	{
-		*(arr) = VALVE_POST_FAULT_ERROR_CODE;
-		result1 = 0;
-	}
-
-//	if(*(arr+1) == VALVE_ON)
-//		vUARTCOM_TXString("CP-Valve 1 On\r\n",15);
-//	if(*(arr+1) == VALVE_OFF)
-//		vUARTCOM_TXString("CP-Valve 1 Off\r\n",16);
-	char result2 = unVALVE_Set2(*(arr+1));
-	if(!result2)
-		*(arr+1) = VALVE_PRE_FAULT_ERROR_CODE;
-	if(result2 == 2)
-	{
-		*(arr+1) = VALVE_POST_FAULT_ERROR_CODE;
-		result2 = 0;
-	}
-
-
-	char result3 = main_Do5TM1();
-	if(result3 == 1){
-		*(arr+4) = i5TM_GetSoil(1);
-		*(arr+5) = i5TM_GetTemp(1);
-	}else if(result3 == 0){
-		*(arr+4) = FIVETM_ERROR_CODE_1;
-	}else if(result3 == 2){
-		*(arr+4) = FIVETM_ERROR_CODE_2;
-		result3 = 0;
-	}
-
-
-
-	char result4 = main_Do5TM2();
-	if(result4 == 1){
-		*(arr+6) = i5TM_GetSoil(2);
-		*(arr+7) = i5TM_GetTemp(2);
-	}else if(result4 == 0){
-		*(arr+6) = FIVETM_ERROR_CODE_1;
-	}else if(result4 == 2){
-		*(arr+6) = FIVETM_ERROR_CODE_2;
-		result4 = 0;
-	}
-
-
-	if(result1 && result2 && result3 && result4)
-		return 1;
-	return 0;
-}
-
-char main_Do5TM1()
-{
-	//UARTDELETE
-//	vUARTCOM_TXString("5TM1 Start\r\n",12);
-	char result = c5TM_Measure1();
-//	if(result == 1)
-//		v5TM_Display(1);
-//	else if(result == 2)
-//		vUARTCOM_TXString("5TM Timeout\r\n",13);
-	//P_5TM_RX_IFG &= ~c5TM_1_RX_PIN;//The turning off of the 5TM causes a falling
-		//edge interrupt. Because we turned off the interrupt, it is not called, but
-		//the flag still exists so when the P2 interrupt is called for the CP COMM,
-		//the flag causes it to enter this interrupt falsely, disturbing communication
-		//greatly(wait for 1200Baud_delay). So as long as these two share the port 2
-		//interrupt, flags must be reset before trying to communicate (They no longer share, but I leave this as warning.)
-	return result;
-}
-
-char main_Do5TM2()
-{
-	//UARTDELETE
-//	vUARTCOM_TXString("5TM2 Start\r\n",12);
-	char result = c5TM_Measure2();
-//	if(result == 1)
-//		v5TM_Display(2);
-//	else if(result == 2)
-//		vUARTCOM_TXString("5TM Timeout\r\n",13);
-	//P_5TM_RX_IFG &= ~c5TM_2_RX_PIN;//The turning off of the 5TM causes a falling
-		//edge interrupt. Because we turned off the interrupt, it is not called, but
-		//the flag still exists so when the P2 interrupt is called for the CP COMM,
-		//the flag causes it to enter this interrupt falsely, disturbing communication
-		//greatly(wait for 1200Baud_delay). So as long as these two share the port 2
-		//interrupt, flags must be reset before trying to communicate (They no longer share, but I leave this as warning.)
-	return result;
-}
-
-///////////////////////////////////////////////////////////////////////////////
-//!   \brief The main file for the SP-CM-STM SP Board
-//!
-//!   Initializes Core, turns off LEDs, initializes UART, 5TM, and Valves
-//!	  Then runs vCORE_Run()
-//!
-//!   \param none
-//!
-//!   \return never
-///////////////////////////////////////////////////////////////////////////////
-void main()
-{
-  //Init the trusted core
-  vCORE_Initilize();
-
-  //P4.3/P4.4 are LEDs
-
-  P4OUT |= BIT3;
-  P4OUT |= BIT4;
-  
-/*  P4OUT &= ~BIT3;
-  P4OUT &= ~BIT4;
-*/
-
-  //UARTDELETE
-//  vUARTCOM_Initialize();
-//  vUARTCOM_TXString( (char*)splash, sizeof splash); //Display the Splash screen of SP-CM-STM
-
-//  vUART_DisplayVoltage();
-
-  // ******************************* nFAULT Test Code
-/*
-  P4OUT |= BIT3;
-  while(true)
-  {
-	  if(P1IN & BIT2)
-		  P4OUT |= BIT3;
-	  else
-		  P4OUT &= !BIT3;
-  }
-*/
-  // *******************************
-
-
-  // Run the device
-  vCORE_Run();
-}
+//*****************************************************************************
+// main.c
+//
+// By: Samuel Boegli
+//     Wireless Networks Research Lab
+//     Dept of Electrical Engineering, CEFNS
+//     Northern Arizona University
+//
+// SP-CM-STM Main
+//*****************************************************************************
+
+#include <msp430x23x.h>
+#include "core/core.h"
+
+//UARTDELETE
+const char splash[] = {"\r\n--------------------------------------------------\r\n     ########      |      NAU WNRL and MSP430\r\n    # $$##$$ #     |	       Present:\r\n     $  ##  $ #    |          SP-CM-STM\r\n      $$##   #     |            V 2.0\r\n        #####      |       No Copyright 2012\r\n        ##$$ #     |\r\n     $  ##  $ #    |    Written and Directed By:\r\n    # $$##$$ #     |         Samuel Boegli\r\n     ########      |\r\n--------------------------------------------------\r\n"};
+//const char splash[] = {"\r\n------------------ SP-CM-STM V2 Code ------------------\r\n"};
+
+char cValve_Initialized = 0;//To make sure we initialize only once.
+char c5TM_Initialized = 0;
+
+
+char main_Do5TM(char sensor);
+char main_Report5TM(uint16 * arr, char sensor, char result);
+char main_ReportValve(uint16 * arr, char valve, char result);
+
+//! @name Transducer Number Bits
+//! Each bit of a transducer number picks a valve or a 5TM to run
+//! @{
+#define MAIN_STM1		0x01	//!< Measure 5TM 1
+#define MAIN_STM2		0x02	//!< Measure 5TM 2
+#define MAIN_CM1		0x04	//!< Set valve 1 from data word 0
+#define MAIN_CM2		0x08	//!< Set valve 2 from data word 1
+//! @}
+
+#if SP_PACKET_PACKED_5TM
+//! @name Packed Record Fields
+//! The record of 5TM n and valve n is in core data words 2n+2 and 2n+3.
+//! See SP_PACKET_PACKED_5TM.
+//! @{
+#define PACKED_5TM_STATUS_SHIFT		14		//!< 5TM status, bits 15-14 of the first word
+#define PACKED_VALVE_STATUS_SHIFT	12		//!< Valve status, bits 13-12 of the first word
+#define PACKED_SOIL_MASK			0x0FFF	//!< Raw soil moisture, bits 11-0 of the first word
+#define PACKED_TEMP_SHIFT			4		//!< Temperature, bits 15-4 of the second word
+//! @}
+
+//! @name Packed Record Status
+//! The values of the 5TM and valve status fields in a packed record
+//! @{
+#define PACKED_NOT_RUN				0x00	//!< The 5TM or valve was not part of this function
+#define PACKED_OK					0x01	//!< Everything went ok
+#define PACKED_5TM_CHECKSUM			0x02	//!< The 5TM answer had a bad checksum
+#define PACKED_5TM_TIMEOUT			0x03	//!< The 5TM did not answer
+#define PACKED_VALVE_PRE_FAULT		0x02	//!< The H-bridge was faulted before the valve was set
+#define PACKED_VALVE_POST_FAULT		0x03	//!< The H-bridge faulted while the valve was set
+//! @}
+#endif
+
+
+
+//Obsolete test functions
+/*
+uint16 vDUMMY_AddData(uint16 * input1, uint16 * input2)
+{
+	*input1 = (*input1 + *(input2+1));
+	return 1;
+}
+
+uint16 vDUMMY_SubtractData(uint16 * input1, uint16 * input2)
+{
+	*input1 = (*input1 - *(input2+1));
+	return 1;
+}
+
+uint16 vDUMMY_MultiplyData(uint16 * input1, uint16 * input2)
+{
+	*input1 = (*input1 * *(input2+1));
+	return 1;
+}
+
+uint16 vDUMMY_DivideData(uint16 * input1, uint16 * input2)
+{
+	*input1 = (*input1 / *(input2+1));
+	return 1;
+}
+*/
+
+
+///////////////////////////////////////////////////////////////////////////////
+//!   \brief Runs the valves and 5TMs picked by the bits of a transducer number
+//!
+//!   The transducer number is a mask of MAIN_STM1, MAIN_STM2, MAIN_CM1 and
+//!   MAIN_CM2, see the transducer labels. The valves are set first, then
+//!   the 5TMs are measured, so a reading is taken after the valve moved.
+//!   Both use TimerB, so they can not overlap. With SP_VALVES_TOGETHER the
+//!   two valves are set with one pulse.
+//!
+//!   \param arr The core data. Words 0 and 1 are the commands of valve 1 and
+//!   2 (0x00: Turn off, 0x5B: Turn on), the results are written here too
+//!   \param mask What to run, 0 runs nothing
+//!
+//!   \return 1: success, 0: failure
+///////////////////////////////////////////////////////////////////////////////
+uint16 main_Transducer(uint16 * arr, char mask)
+{
+	char result = 1;
+
+	if((mask & (MAIN_CM1 | MAIN_CM2)) && !cValve_Initialized)
+	{
+		vVALVE_Initialize();
+		cValve_Initialized = 1;
+	}
+	if((mask & (MAIN_STM1 | MAIN_STM2)) && !c5TM_Initialized)
+	{
+		v5TM_Initialize();
+		c5TM_Initialized = 1;
+	}
+
+#if SP_VALVES_TOGETHER
+	if((mask & (MAIN_CM1 | MAIN_CM2)) == (MAIN_CM1 | MAIN_CM2))
+	{
+		// nFAULT is shared, so one result goes for both valves
+		char both = unVALVE_SetBoth(*arr, *(arr+1));
+		result &= main_ReportValve(arr, 1, both);
+		result &= main_ReportValve(arr, 2, both);
+		mask &= ~(MAIN_CM1 | MAIN_CM2);
+	}
+#endif
+	if(mask & MAIN_CM1)
+		result &= main_ReportValve(arr, 1, unVALVE_Set1(*arr));
+	if(mask & MAIN_CM2)
+		result &= main_ReportValve(arr, 2, unVALVE_Set2(*(arr+1)));
+
+	if(mask & MAIN_STM1)
+		result &= main_Report5TM(arr, 1, main_Do5TM(1));
+	if(mask & MAIN_STM2)
+		result &= main_Report5TM(arr, 2, main_Do5TM(2));
+
+	return result;
+}
+
+//! \def MAIN_TRANSDUCER
+//! \brief Defines the transducer function \e name, which runs
+//! main_Transducer() with \e mask, its transducer number
+#define MAIN_TRANSDUCER(name, mask) \
+	uint16 name(uint16 * arr) { return main_Transducer(arr, mask); }
+
+//! @name Transducer Functions
+//! The functions of transducers 0 to F, declared in changeable_core_header.h
+//! @{
+MAIN_TRANSDUCER(main_Test,			0)
+MAIN_TRANSDUCER(main_STM1,			MAIN_STM1)
+MAIN_TRANSDUCER(main_STM2,			MAIN_STM2)
+MAIN_TRANSDUCER(main_STM12,			MAIN_STM1 | MAIN_STM2)
+MAIN_TRANSDUCER(main_CM1,			MAIN_CM1)
+MAIN_TRANSDUCER(main_CM1_STM1,		MAIN_CM1 | MAIN_STM1)
+MAIN_TRANSDUCER(main_CM1_STM2,		MAIN_CM1 | MAIN_STM2)
+MAIN_TRANSDUCER(main_CM1_STM12,		MAIN_CM1 | MAIN_STM1 | MAIN_STM2)
+MAIN_TRANSDUCER(main_CM2,			MAIN_CM2)
+MAIN_TRANSDUCER(main_CM2_STM1,		MAIN_CM2 | MAIN_STM1)
+MAIN_TRANSDUCER(main_CM2_STM2,		MAIN_CM2 | MAIN_STM2)
+MAIN_TRANSDUCER(main_CM2_STM12,		MAIN_CM2 | MAIN_STM1 | MAIN_STM2)
+MAIN_TRANSDUCER(main_CM12,			MAIN_CM1 | MAIN_CM2)
+MAIN_TRANSDUCER(main_CM12_STM1,		MAIN_CM1 | MAIN_CM2 | MAIN_STM1)
+MAIN_TRANSDUCER(main_CM12_STM2,		MAIN_CM1 | MAIN_CM2 | MAIN_STM2)
+MAIN_TRANSDUCER(main_CM12_STM12,	MAIN_CM1 | MAIN_CM2 | MAIN_STM1 | MAIN_STM2)
+//! @}
+
+///////////////////////////////////////////////////////////////////////////////
+//!   \brief Measures a 5TM
+//!
+//!   \param sensor 1: 5TM 1, 2: 5TM 2
+//!
+//!   \return 1: success, 0: checksum error, 2: timeout
+///////////////////////////////////////////////////////////////////////////////
+char main_Do5TM(char sensor)
+{
+	//UARTDELETE
+//	vUARTCOM_TXString("5TM Start\r\n",11);
+	char result;
+	if(sensor == 1)
+		result = c5TM_Measure1();
+	else
+		result = c5TM_Measure2();
+//	if(result == 1)
+//		v5TM_Display(sensor);
+//	else if(result == 2)
+//		vUARTCOM_TXString("5TM Timeout\r\n",13);
+	//P_5TM_RX_IFG &= ~c5TM_1_RX_PIN;//The turning off of the 5TM causes a falling
+		//edge interrupt. Because we turned off the interrupt, it is not called, but
+		//the flag still exists so when the P2 interrupt is called for the CP COMM,
+		//the flag causes it to enter this interrupt falsely, disturbing communication
+		//greatly(wait for 1200Baud_delay). So as long as these two share the port 2
+		//interrupt, flags must be reset before trying to communicate (They no longer share, but I leave this as warning.)
+	return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//!   \brief Writes the result of a 5TM measurement where the report takes it
+//!
+//!   Soil moisture and temperature go in words 4 and 5 for 5TM 1, 6 and 7
+//!   for 5TM 2, or an error code in the first of them. With
+//!   SP_PACKET_PACKED_5TM they go in the packed record of the 5TM instead.
+//!
+//!   \param arr The core data
+//!   \param sensor 1: 5TM 1, 2: 5TM 2
+//!   \param result What main_Do5TM() returned
+//!
+//!   \return 1: success, 0: failure
+///////////////////////////////////////////////////////////////////////////////
+char main_Report5TM(uint16 * arr, char sensor, char result)
+{
+	uint16 * record = arr + 2 + 2 * sensor;
+
+#if SP_PACKET_PACKED_5TM
+	if(result == 1){
+		*record |= ((uint16)PACKED_OK << PACKED_5TM_STATUS_SHIFT) |
+			(((uint16)i5TM_GetSoil(sensor) >> 1) & PACKED_SOIL_MASK);
+		*(record+1) = (uint16)i5TM_GetSignedTemp(sensor) << PACKED_TEMP_SHIFT;
+	}else if(result == 0){
+		*record |= (uint16)PACKED_5TM_CHECKSUM << PACKED_5TM_STATUS_SHIFT;
+	}else if(result == 2){
+		*record |= (uint16)PACKED_5TM_TIMEOUT << PACKED_5TM_STATUS_SHIFT;
+		result = 0;
+	}
+#else
+	if(result == 1){
+		*record = i5TM_GetSoil(sensor);
+		*(record+1) = i5TM_GetTemp(sensor);
+	}else if(result == 0){
+		*record = FIVETM_ERROR_CODE_1;
+	}else if(result == 2){
+		*record = FIVETM_ERROR_CODE_2;
+		result = 0;
+	}
+#endif
+	return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//!   \brief Writes the result of setting a valve where the report takes it
+//!
+//!   An error code goes in the command word of the valve, word 0 for valve 1
+//!   and word 1 for valve 2. With SP_PACKET_PACKED_5TM the status goes in the
+//!   packed record of the valve instead, and the command word is cleared.
+//!
+//!   \param arr The core data
+//!   \param valve 1: valve 1, 2: valve 2
+//!   \param result What unVALVE_Set1(), unVALVE_Set2() or unVALVE_SetBoth()
+//!   returned
+//!
+//!   \return 1: success, 0: failure
+///////////////////////////////////////////////////////////////////////////////
+char main_ReportValve(uint16 * arr, char valve, char result)
+{
+#if SP_PACKET_PACKED_5TM
+	uint16 * record = arr + 2 + 2 * valve;
+	uint16 status = PACKED_OK;
+
+	if(!result)
+		status = PACKED_VALVE_PRE_FAULT;
+	if(result == 2)
+		status = PACKED_VALVE_POST_FAULT;
+	*record |= status << PACKED_VALVE_STATUS_SHIFT;
+	*(arr + valve - 1) = 0;
+#else
+	if(!result)
+		*(arr + valve - 1) = VALVE_PRE_FAULT_ERROR_CODE;
+	if(result == 2)
+		*(arr + valve - 1) = VALVE_POST_FAULT_ERROR_CODE;
+#endif
+	if(result == 2)
+		result = 0;
+	return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//!   \brief The main file for the SP-CM-STM SP Board
+//!
+//!   Initializes Core, turns off LEDs, initializes UART, 5TM, and Valves
+//!	  Then runs vCORE_Run()
+//!
+//!   \param none
+//!
+//!   \return never
+///////////////////////////////////////////////////////////////////////////////
+void main()
+{
+  //Init the trusted core
+  vCORE_Initilize();
+
+  //P4.3/P4.4 are LEDs
+
+  P4OUT |= BIT3;
+  P4OUT |= BIT4;
+  
+/*  P4OUT &= ~BIT3;
+  P4OUT &= ~BIT4;
+*/
+
+  //UARTDELETE
+//  vUARTCOM_Initialize();
+//  vUARTCOM_TXString( (char*)splash, sizeof splash); //Display the Splash screen of SP-CM-STM
+
+//  vUART_DisplayVoltage();
+
+  // ******************************* nFAULT Test Code
+/*
+  P4OUT |= BIT3;
+  while(true)
+  {
+	  if(P1IN & BIT2)
+		  P4OUT |= BIT3;
+	  else
+		  P4OUT &= !BIT3;
+  }
+*/
+  // *******************************
+
+
+  // Run the device
+  vCORE_Run();
+}